@@ -0,0 +1,108 @@
+/* ******************************* atom_table.c ****************************** */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Intern the identifiers so they can be compared as pointers  */
+/* *************************************************************************** */
+
+#include "atom_table.h"   // header file
+#include <stdlib.h>       // calloc(), free()
+#include <string.h>       // memcmp()
+
+/**
+ * Computes the hash of the string (FNV-1a).
+ *
+ * @param str String to be hashed
+ * @param n Length of the string
+ * @returns The hash of the string
+ */
+static uint32_t atom_hash(const char *str, size_t n){
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < n; i++){
+        hash ^= (unsigned char) str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Moves all the atoms into a table twice as big.
+ *
+ * @param table Table to be grown
+ * @returns true if the table was grown, false if the allocation failed
+ */
+static bool atom_table_grow(Atom_Table_T *table){
+    size_t capacity = (table->capacity == 0) ? ATOM_TABLE_DEFAULT_SIZE : table->capacity * 2;
+    Atom_Entry_T *slots = (Atom_Entry_T *) calloc(capacity, sizeof(Atom_Entry_T));
+    if (slots == NULL) // Calloc failed
+        return false;
+
+    for (size_t i = 0; i < table->capacity; i++){
+        if (table->slots[i].str == NULL)
+            continue;
+        size_t j = table->slots[i].hash & (capacity - 1);
+        while (slots[j].str != NULL) // Linear probing
+            j = (j + 1) & (capacity - 1);
+        slots[j] = table->slots[i];
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+    return true;
+}
+
+/**
+ * Initializes a new (empty) table.
+ *
+ * @param table Table to be initialized
+ */
+void atom_table_init(Atom_Table_T *table){
+    table->slots = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    str_pool_init(&table->strs);
+}
+
+/**
+ * Returns the atom of n characters of the string (interns the string the first time).
+ *
+ * @param table Table of the atoms
+ * @param str String to be interned (doesn't have to be '\0' terminated)
+ * @param n Length of the string
+ * @returns The atom ('\0' terminated), NULL if the allocation failed
+ */
+char *atom_intern(Atom_Table_T *table, const char *str, size_t n){
+    if (n >= UINT32_MAX)
+        return NULL;
+    if (2 * (table->count + 1) > table->capacity && !atom_table_grow(table)) // Keep the table at most half full
+        return NULL;
+
+    uint32_t hash = atom_hash(str, n);
+    size_t i = hash & (table->capacity - 1);
+    while (table->slots[i].str != NULL){ // Linear probing
+        Atom_Entry_T *entry = &table->slots[i];
+        if (entry->hash == hash && entry->len == n && memcmp(entry->str, str, n) == 0)
+            return entry->str; // Interned already
+        i = (i + 1) & (table->capacity - 1);
+    }
+
+    char *atom = str_pool_add(&table->strs, str, n);
+    if (atom == NULL) // Allocation failed
+        return NULL;
+    table->slots[i].str = atom;
+    table->slots[i].hash = hash;
+    table->slots[i].len = (uint32_t) n;
+    table->count++;
+    return atom;
+}
+
+/**
+ * Frees the table along with all the atoms.
+ *
+ * @param table Table to be cleaned
+ */
+void atom_table_clean(Atom_Table_T *table){
+    free(table->slots);
+    str_pool_clean(&table->strs);
+    atom_table_init(table);
+}
+/* End of atom_table.c */
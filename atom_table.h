@@ -0,0 +1,79 @@
+/* ******************************* atom_table.h ****************************** */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Header file for atom_table.c                                */
+/* *************************************************************************** */
+
+#ifndef ATOM_TABLE_H
+#define ATOM_TABLE_H
+
+#include "str_pool.h"
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint32_t, uint64_t, uintptr_t
+#include <stdbool.h>
+
+/* Initial number of slots of the table (has to be a power of 2) */
+#define ATOM_TABLE_DEFAULT_SIZE 1024
+
+/*
+ * / ********************* Atom_Entry_T ********************* \
+ * / Structure that holds one interned string (atom) and its hash \
+*/
+typedef struct Atom_Entry {
+    char *str;       // Interned string (NULL ~ empty slot)
+    uint32_t hash;   // Hash of the string
+    uint32_t len;    // Length of the string
+} Atom_Entry_T;
+
+/*
+ * / **************************** Atom_Table_T **************************** \
+ * / Structure that holds exactly one copy (atom) of every interned string \
+ * / Equal strings are interned as the same pointer, so the atoms can be  \
+ * / compared by their addresses instead of strcmp()                      \
+*/
+typedef struct Atom_Table {
+    Atom_Entry_T *slots;   // Open addressing hash table of the atoms
+    size_t count;          // Number of the atoms
+    size_t capacity;       // Number of the slots
+    Str_Pool_T strs;       // Memory of the atoms (valid until the table is cleaned)
+} Atom_Table_T;
+
+/*
+ * / ************* atom_table_init() ************** \
+ * / Function that initializes a new (empty) table \
+*/
+void atom_table_init(Atom_Table_T *table);
+
+/*
+ * / ********************* atom_intern() ********************** \
+ * / Function that returns the atom of n characters of the string \
+*/
+char *atom_intern(Atom_Table_T *table, const char *str, size_t n);
+
+/*
+ * / ***************** atom_table_clean() ****************** \
+ * / Function that frees the table along with all the atoms \
+*/
+void atom_table_clean(Atom_Table_T *table);
+
+/*
+ * / ******************** atom_cmp() ******************** \
+ * / Function that orders two atoms (by their addresses) \
+*/
+static inline int atom_cmp(const char *atom1, const char *atom2){
+    uintptr_t a = (uintptr_t) atom1, b = (uintptr_t) atom2;
+    return (a > b) - (a < b);
+}
+
+/*
+ * / ***************** atom_addr_hash() ****************** \
+ * / Function that hashes an atom (by its address, so the   \
+ * / characters are never read)                             \
+*/
+static inline size_t atom_addr_hash(const char *atom){
+    uint64_t hash = (uint64_t) (uintptr_t) atom * 0x9E3779B97F4A7C15ULL; // Fibonacci hashing
+    return (size_t) (hash ^ (hash >> 32));
+}
+
+#endif
+/* End of atom_table.h */
@@ -0,0 +1,96 @@
+/* ***************************** scanner_bench.c ***************************** */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Measure the throughput of get_token() (make bench_scanner)  */
+/* *************************************************************************** */
+
+/*
+ * Scans a source with get_token() until EOF and prints the best throughput of BENCH_RUNS runs
+ * The source is a file given as the argument, or a generated IFJ23 program of about 32 MB
+ * (comments, definitions, string / float literals and if statements, see generate_source())
+ *
+ * Only set_file() and get_token() are used, so the benchmark builds with older versions of the scanner too:
+ *     git worktree add /tmp/ifj_old <commit>
+ *     make bench_scanner BENCH_DIR=/tmp/ifj_old
+ */
+
+#define _POSIX_C_SOURCE 200809L   // clock_gettime(), fileno()
+
+#include "scanner.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/stat.h>
+
+// Number of the measured runs (the best one is printed)
+#define BENCH_RUNS 5
+
+// Number of the statements of the generated source (about 32 MB)
+#define BENCH_STATEMENTS 600000L
+
+/**
+ * Writes the generated source to the stream.
+ *
+ * @param f Stream to write the source to
+ * @param n Number of the statements
+ */
+static void generate_source(FILE *f, long n){
+    fprintf(f, "var acc = 0\nvar s = \"x\"\n");
+    for (long i = 0; i < n; i++){
+        switch (i % 6){
+            case 0:  fprintf(f, "// line comment number %ld with some text in it to skip over quickly\n", i); break;
+            case 1:  fprintf(f, "var v%ld = acc + %ld * (acc - %ld)\n", i, i, i + 1); break;
+            case 2:  fprintf(f, "/* block comment %ld spanning\n   multiple lines of text */\n", i); break;
+            case 3:  fprintf(f, "let str%ld = \"some string literal number %ld with text\"\n", i, i); break;
+            case 4:  fprintf(f, "let f%ld = %ld.%lde%ld\n", i, i, i % 97, i % 20); break;
+            default: fprintf(f, "if acc >= %ld {\n  acc = acc + 1\n} else {\n  acc = acc - 1\n}\n", i); break;
+        }
+    }
+}
+
+/**
+ * Returns the time of a monotonic clock.
+ *
+ * @returns Time in seconds
+ */
+static double now(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]){
+    FILE *f = (argc > 1) ? fopen(argv[1], "r") : tmpfile();
+    if (f == NULL){
+        fprintf(stderr, "scanner_bench: can't open the source\n");
+        return 1;
+    }
+    if (argc <= 1){
+        generate_source(f, BENCH_STATEMENTS);
+        fflush(f);
+    }
+    // The size is taken from the file, seeking to its end would move the offset the mapped input starts at
+    struct stat st;
+    long size = (fstat(fileno(f), &st) == 0) ? (long) st.st_size : 0;
+
+    double best = 0.0;
+    long tokens = 0;
+    for (int run = 0; run < BENCH_RUNS; run++){
+        fseek(f, 0, SEEK_SET); // Every run scans the source from its start
+        set_file(f);
+        Token_T token;
+        long count = 0;
+        double start = now();
+        while (get_token(&token) == 0 && token.token_type != TOKEN_EOF)
+            count++;
+        double time = now() - start;
+        if (run == 0 || time < best)
+            best = time;
+        tokens = count;
+    }
+    fclose(f);
+
+    printf("scanner: %ld bytes, %ld tokens, %.1f MB/s (best of %d)\n", size, tokens, size / best / 1e6, BENCH_RUNS);
+    return 0;
+}
+/* End of scanner_bench.c */
@@ -0,0 +1,31 @@
+// Factorial computed iteratively and recursively
+
+func factorial(_ n : Int) -> Int {
+    if (n < 2) {
+        return 1
+    } else {
+        let decremented_n = n - 1
+        let temp_result : Int = factorial(decremented_n)
+        let result = n * temp_result
+        return result
+    }
+}
+
+func factorial_loop(_ n : Int) {
+    var vysl = 1
+    var a = n
+    while (a > 0) {
+        vysl = vysl * a
+        a = a - 1
+    }
+    write("Vysledek (iterativne): ", vysl, "\n")
+}
+
+let inp = 10
+if (inp < 0) {
+    write("Faktorial nelze spocitat!\n")
+} else {
+    factorial_loop(inp)
+    let rec : Int = factorial(inp)
+    write("Vysledek (rekurzivne): ", rec, "\n")
+}
@@ -0,0 +1,77 @@
+// Prime numbers, greatest common divisors and sums of the divisors
+
+func is_prime(_ n : Int) -> Int {
+    if (n < 2) {
+        return 0
+    } else {
+        var divisor = 2
+        var prime = 1
+        while (divisor * divisor <= n) {
+            let quotient = n / divisor
+            if (quotient * divisor == n) {
+                prime = 0
+            } else {
+            }
+            divisor = divisor + 1
+        }
+        if (prime == 1) {
+            return 1
+        } else {
+            return 0
+        }
+    }
+}
+
+func gcd(of a : Int, and b : Int) {
+    var x = a
+    var y = b
+    while (y != 0) {
+        let q = x / y
+        let r = x - q * y
+        x = y
+        y = r
+    }
+    write("gcd(", a, ", ", b, ") = ", x, "\n")
+}
+
+func divisor_sum(_ n : Int) -> Int {
+    if (n < 2) {
+        return 0
+    } else {
+        var sum = 0
+        var d = 1
+        while (d < n) {
+            let q = n / d
+            if (q * d == n) {
+                sum = sum + d
+            } else {
+            }
+            d = d + 1
+        }
+        if (sum > 0) {
+            return sum
+        } else {
+            return 0
+        }
+    }
+}
+
+var count = 0
+var number = 2
+let limit = 100
+while (number < limit) {
+    let prime : Int = is_prime(number)
+    if (prime == 1) {
+        count = count + 1
+        write(number, " ")
+    } else {
+        let sum : Int = divisor_sum(number)
+        if (sum == number) {
+            write("(perfect ", number, ") ")
+        } else {
+        }
+    }
+    number = number + 1
+}
+write("\n", count, " primes below ", limit, "\n")
+gcd(of: 1071, and: 462)
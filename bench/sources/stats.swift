@@ -0,0 +1,61 @@
+// Statistics of a sequence of numbers
+
+func abs_value(_ x : Double) -> Double {
+    if (x < 0.0) {
+        return 0.0 - x
+    } else {
+        return x
+    }
+}
+
+func sqrt_approx(_ value : Double, steps count : Int) -> Double {
+    var guess = value / 2.0
+    var step = 0
+    while (step < count) {
+        let better = (guess + value / guess) / 2.0
+        guess = better
+        step = step + 1
+    }
+    if (guess > 0.0) {
+        return guess
+    } else {
+        return 0.0
+    }
+}
+
+var total = 0.0
+var total_sq = 0.0
+var n = 0
+var minimum = 0.0
+var maximum = 0.0
+var value = 1.5
+while (n < 50) {
+    if (n == 0) {
+        minimum = value
+        maximum = value
+    } else {
+        if (value < minimum) {
+            minimum = value
+        } else {
+        }
+        if (value > maximum) {
+            maximum = value
+        } else {
+        }
+    }
+    total = total + value
+    total_sq = total_sq + value * value
+    n = n + 1
+    value = value * 1.7 - 3.25
+}
+if (n > 0) {
+    let count : Double = Int2Double(n)
+    let mean = total / count
+    let variance = total_sq / count - mean * mean
+    let spread : Double = abs_value(variance)
+    let deviation : Double = sqrt_approx(spread, steps: 20)
+    write("n = ", n, "\nmean = ", mean, "\nmin = ", minimum, "\nmax = ", maximum, "\n")
+    write("deviation = ", deviation, "\n")
+} else {
+    write("No numbers\n")
+}
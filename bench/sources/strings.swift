@@ -0,0 +1,38 @@
+// Work with strings and the built-in functions
+
+func concat(_ x : String, with y : String) -> String {
+    let xy = x + y
+    if (y == "") {
+        return x
+    } else {
+        return xy + " " + y
+    }
+}
+
+let a = "Ahoj "
+var ct : String = concat(a, with: "svete")
+write(ct, "\n")
+
+let s1 : String = "Toto je nejaky text v programu jazyka IFJ23"
+let s2 = s1 + ", ktery jeste trochu obohatime"
+write(s1, "\n", s2, "\n")
+let s1len : Int = length(s1)
+var s1len4 = s1len - 4
+let s1sub = substring(of: s2, startingAt: s1len4, endingBefore: s1len)
+write("4 znaky od ", s1len4, ". znaku v \"", s2, "\": ", s1sub, "\n")
+
+var attempts = 0
+var all : String = ""
+while (attempts < 3) {
+    let input = "abcdefgh"
+    if (input == "abcdefgh") {
+        write("Spravne zadano!\n", all, "\n")
+    } else {
+        write("Spatne zadana posloupnost, zkuste znovu:\n")
+    }
+    all = all + input
+    attempts = attempts + 1
+}
+let code : Int = ord(all)
+let first : String = chr(code)
+write(first, "\n")
@@ -0,0 +1,193 @@
+/* ****************************** symtable_bench.c ****************************** */
+/*  Subject: IFJ/IAL - Project                                                    */
+/*  Date: 17. 10. 2026                                                            */
+/*  Functionality: Replay the identifiers of real sources through a symbol table  */
+/* ****************************************************************************** */
+
+/*
+ * Every source (the arguments) is scanned and the ids of its variables and functions
+ * are replayed in their order through a new table: an id is looked up and inserted
+ * if it isn't in the table yet (like the first declaration of it)
+ * The replay is repeated until it takes BENCH_MIN_TIME, the time per id is printed
+ * make bench_symtable builds the bench for both backends and prints their times side by side
+ * (-t prints the times only), the sources are bench/sources/*.swift and the programs
+ * generated by -g N (N parts, each has two functions and the code of the main program using them)
+ */
+
+#define _POSIX_C_SOURCE 200809L   // clock_gettime()
+
+#include "scanner.h"
+#include "symtable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Minimum time of the replays of one source (in seconds)
+#define BENCH_MIN_TIME 0.2
+
+/*
+ * / ********************* Id_Stream_T ******************** \
+ * / Structure that holds the ids of a source in their order \
+*/
+typedef struct Id_Stream {
+    char **ids;         // Ids (atoms of the scanner)
+    long count;         // Number of the ids
+    long capacity;      // Number of the allocated ids
+} Id_Stream_T;
+
+/**
+ * Returns the time of a monotonic clock.
+ *
+ * @returns Time in seconds
+ */
+static double now(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Prints a program that compiles with the subset of IFJ23 the compiler handles.
+ * The ids repeat like in real sources: the parameters and locals of the functions
+ * have the same names everywhere, the functions and the globals are unique.
+ *
+ * @param parts Number of the parts of the program
+ */
+static void generate(long parts){
+    printf("// Program generated by symtable_bench -g %ld\n", parts);
+    for (long i = 0; i < parts; i++){
+        printf("func step_%ld(_ a : Int, _ b : Int) -> Int {\n", i);
+        printf("    let d = a - b\n");
+        printf("    if (d > 0) {\n        return d\n    } else {\n        return b - a\n    }\n}\n");
+        printf("func report_%ld(_ n : Int, label s : String) {\n", i);
+        printf("    var i = 0\n    var sum = 0\n");
+        printf("    while (i < n) {\n        let v = i * %ld\n        sum = sum + v\n        i = i + 1\n    }\n", i % 7 + 1);
+        printf("    write(s, sum, \"\\n\")\n}\n");
+        printf("var x_%ld : Int = step_%ld(%ld, %ld)\n", i, i, i, i * 3 % 11);
+        printf("let y_%ld = x_%ld * 2 + %ld\n", i, i, i % 5);
+        printf("report_%ld(y_%ld, label: \"part %ld: \")\n", i, i, i);
+    }
+}
+
+/**
+ * Scans the source and collects the ids of its variables and functions.
+ *
+ * @param path Path of the source
+ * @param stream Stream to be filled (empty)
+ * @returns 0 if success, 1 otherwise
+ */
+static int read_ids(const char *path, Id_Stream_T *stream){
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+        return 1;
+    set_file(f);
+    Token_T token;
+    int error;
+    while ((error = get_token(&token)) == 0 && token.token_type != TOKEN_EOF){
+        if (token.token_type != TOKEN_VAR_ID && token.token_type != TOKEN_FUNC_ID)
+            continue;
+        if (stream->count == stream->capacity){
+            long capacity = (stream->capacity == 0) ? 64 : stream->capacity * 2;
+            char **ids = (char **) realloc(stream->ids, capacity * sizeof(char *));
+            if (ids == NULL){ // Realloc failed
+                fclose(f);
+                return 1;
+            }
+            stream->ids = ids;
+            stream->capacity = capacity;
+        }
+        stream->ids[stream->count++] = token.token_value.str; // The ids are atoms, they stay valid
+    }
+    fclose(f);
+    return (error == 0) ? 0 : 1;
+}
+
+/**
+ * Replays the ids through a new table.
+ *
+ * @param stream Ids of a source
+ * @returns Number of the distinct ids (-1 if an insert failed)
+ */
+static long replay(Id_Stream_T *stream){
+    TData_var var_data;
+    TData_func func_data;
+    memset(&var_data, 0, sizeof(TData_var));
+    memset(&func_data, 0, sizeof(TData_func));
+    TTree table;
+    init_symtable(&table);
+
+    long distinct = 0;
+    for (long i = 0; i < stream->count; i++){
+        if (search_symbol(&table, stream->ids[i]) != NULL)
+            continue;
+        if (insert_symbol(&table, stream->ids[i], VARIABLE, var_data, func_data) == 0){
+            distinct = -1;
+            break;
+        }
+        distinct++;
+    }
+    dispose_symtable(&table);
+    return distinct;
+}
+
+int main(int argc, char *argv[]){
+    if (argc == 3 && strcmp(argv[1], "-g") == 0){
+        generate(atol(argv[2]));
+        return 0;
+    }
+    bool times_only = (argc > 1 && strcmp(argv[1], "-t") == 0);
+    int first = times_only ? 2 : 1;
+    if (argc <= first){
+        fprintf(stderr, "usage: symtable_bench [-t] source...\n       symtable_bench -g parts\n");
+        return 1;
+    }
+#ifndef SYMTABLE_HASH
+    const char *backend = "avl";
+#else
+    const char *backend = "hash";
+#endif
+    if (times_only)
+        printf("%9s\n", backend);
+    else
+        printf("%-40s %9s %9s %9s\n", "source (ns per id)", "ids", "distinct", backend);
+
+    double total_time = 0.0;
+    double total_ids = 0.0;
+    for (int i = first; i < argc; i++){
+        Id_Stream_T stream = {NULL, 0, 0};
+        if (read_ids(argv[i], &stream) != 0 || stream.count == 0){
+            fprintf(stderr, "symtable_bench: no ids in %s\n", argv[i]);
+            if (times_only) // The row is kept, so the columns of both backends stay aligned
+                printf("%9s\n", "-");
+            else
+                printf("%-40s %9s %9s %9s\n", argv[i], "-", "-", "-");
+            free(stream.ids);
+            continue;
+        }
+
+        long distinct = 0, runs = 0;
+        double start = now(), time;
+        do { // The sources are small, so the replay is repeated
+            if ((distinct = replay(&stream)) < 0){
+                fprintf(stderr, "symtable_bench: insert failed\n");
+                return 1;
+            }
+            runs++;
+        } while ((time = now() - start) < BENCH_MIN_TIME);
+
+        if (times_only)
+            printf("%9.1f\n", time / runs / stream.count * 1e9);
+        else
+            printf("%-40s %9ld %9ld %9.1f\n", argv[i], stream.count, distinct, time / runs / stream.count * 1e9);
+        total_time += time / runs;
+        total_ids += stream.count;
+        free(stream.ids);
+    }
+    if (total_ids > 0 && times_only)
+        printf("%9.1f\n", total_time / total_ids * 1e9);
+    else if (total_ids > 0)
+        printf("%-40s %9.0f %9s %9.1f\n", "all sources", total_ids, "", total_time / total_ids * 1e9);
+    return 0;
+}
+/* End of symtable_bench.c */
@@ -0,0 +1,128 @@
+/* ************************** symtable_insert_bench.c ************************** */
+/*  Subject: IFJ/IAL - Project                                                   */
+/*  Date: 17. 10. 2026                                                           */
+/*  Functionality: Measure inserts into and lookups in one big symbol table      */
+/* ***************************************************************************** */
+
+/*
+ * For every size n (10^3, 10^5 and 10^6 by default, or the arguments) n distinct ids are inserted
+ * into an empty table in a shuffled order and all of them are looked up again in another order
+ * Built by make bench_symtable_insert (the backend is picked by SYMTABLE=avl / hash)
+ *
+ * The symtables older than the hash backend took the root of the tree instead of the table,
+ * build the benchmark for them with -DSYMTABLE_ROOT_API:
+ *     git worktree add /tmp/ifj_old <commit>
+ *     make bench_symtable_insert BENCH_DIR=/tmp/ifj_old BENCH_DEFS=-DSYMTABLE_ROOT_API BENCH_ARGS=8000
+ */
+
+#define _POSIX_C_SOURCE 200809L   // clock_gettime()
+
+#include "symtable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Returns the time of a monotonic clock.
+ *
+ * @returns Time in seconds
+ */
+static double now(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Shuffles the ids (Fisher-Yates with a fixed LCG, every run uses the same order).
+ *
+ * @param ids Ids to be shuffled
+ * @param n Number of the ids
+ * @param seed Seed of the generator
+ */
+static void shuffle(char **ids, long n, unsigned long long seed){
+    for (long i = n - 1; i > 0; i--){
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        long j = (long) ((seed >> 33) % (unsigned long long) (i + 1));
+        char *tmp = ids[i];
+        ids[i] = ids[j];
+        ids[j] = tmp;
+    }
+}
+
+/**
+ * Inserts n distinct ids into an empty table, looks them up and prints the times.
+ *
+ * @param n Number of the ids
+ * @returns 0 if success, 1 otherwise
+ */
+static int bench_size(long n){
+    // Every id is allocated once, so the ids are atoms (see atom_table.h)
+    char **ids = (char **) malloc(n * sizeof(char *));
+    char *names = (char *) malloc(n * 16);
+    if (ids == NULL || names == NULL){
+        free(ids);
+        free(names);
+        return 1;
+    }
+    for (long i = 0; i < n; i++){
+        ids[i] = names + i * 16;
+        sprintf(ids[i], "id_%ld", i);
+    }
+    shuffle(ids, n, 1);
+
+    TData_var var_data;
+    TData_func func_data;
+    memset(&var_data, 0, sizeof(TData_var));
+    memset(&func_data, 0, sizeof(TData_func));
+    TTree table;
+    init_symtable(&table);
+
+    double start = now();
+    for (long i = 0; i < n; i++){
+#ifndef SYMTABLE_ROOT_API
+        if (insert_symbol(&table, ids[i], VARIABLE, var_data, func_data) == 0){
+#else
+        if (insert_symbol(&table.root, ids[i], VARIABLE, var_data, func_data, &table) == 0){
+#endif
+            fprintf(stderr, "symtable_insert_bench: insert failed\n");
+            return 1;
+        }
+    }
+    double insert_time = now() - start;
+
+    shuffle(ids, n, 2);
+    long found = 0;
+    start = now();
+    for (long i = 0; i < n; i++){
+#ifndef SYMTABLE_ROOT_API
+        found += (search_symbol(&table, ids[i]) != NULL);
+#else
+        found += (search_symbol(table.root, ids[i]) != NULL);
+#endif
+    }
+    double search_time = now() - start;
+
+    printf("%8ld ids: inserts %.3f s (%.0f ns each), lookups %.3f s (%.0f ns each)%s\n", n,
+           insert_time, insert_time / n * 1e9, search_time, search_time / n * 1e9,
+           (found == n) ? "" : ", SOME IDS WERE NOT FOUND");
+    dispose_symtable(&table);
+    free(ids);
+    free(names);
+    return (found == n) ? 0 : 1;
+}
+
+int main(int argc, char *argv[]){
+    long default_sizes[] = {1000, 100000, 1000000};
+    int result = 0;
+    if (argc > 1){
+        for (int i = 1; i < argc; i++)
+            result |= bench_size(atol(argv[i]));
+    } else {
+        for (int i = 0; i < 3; i++)
+            result |= bench_size(default_sizes[i]);
+    }
+    return result;
+}
+/* End of symtable_insert_bench.c */
@@ -14,41 +14,15 @@
 
 /**
  * Prints string in IFJcode form
+ * The form is made by the scanner already, so it is just written out
  *
- * @param intput string to be printed
+ * @param intput string literal to be printed (value of a TOKEN_STR or TOKEN_M_LINE_STR token)
  * 
  */
 void print_string_in_ifjcode_form(char *input) {
-    size_t lenght = strlen(input);
-    Dynamic_Str_T result;
-    dynamic_str_init(&result);
-
-    for (size_t i = 0; i < lenght; i++)
-    {
-        if (input[i] >= 0 && input[i] <= 32){
-            
-            int a = input[i]/10; //first digit
-            int b = input[i]%10; //second digit
-
-            append_char_to_str(&result,'\\');
-            append_char_to_str(&result, '0');
-            append_char_to_str(&result, (char)(a + '0'));
-            append_char_to_str(&result, (char)(b + '0'));
-        }else if (input[i] == '\\'){
-            append_char_to_str(&result,'\\');
-            append_char_to_str(&result, '0');
-            append_char_to_str(&result, '9');
-            append_char_to_str(&result, '2');
-        }else if (input[i] == '#'){
-            append_char_to_str(&result,'\\');
-            append_char_to_str(&result, '0');
-            append_char_to_str(&result, '3');
-            append_char_to_str(&result, '5');
-        }else{
-            append_char_to_str(&result, input[i]);
-        }   
-    }
-    printf("%s", result.dynamic_str);
+    size_t lenght;
+    const char *ifj_str = str_lit_ifjcode(input, &lenght);
+    fwrite(ifj_str, 1, lenght, stdout);
 }
 
 // Prints literal value or variable with corresponding frame
@@ -56,7 +30,7 @@ void get_frame(Token_T token, Parser_T *struct_parser){
     if(token.token_type == TOKEN_VAR_ID){
         if(struct_parser->inside_main == true){
             printf("GF@__");}else{printf("LF@__");}
-            printf("%s__", token.token_value.dyn_str.dynamic_str);
+            printf("%s__", token.token_value.str);
             printf(" ");}
     else if(token.token_type == TOKEN_INT){
             char num[50];
@@ -72,7 +46,7 @@ void get_frame(Token_T token, Parser_T *struct_parser){
             printf(" ");
         }else if(token.token_type == TOKEN_STR || token.token_type == TOKEN_M_LINE_STR){
             printf("string@");
-            print_string_in_ifjcode_form(token.token_value.dyn_str.dynamic_str);
+            print_string_in_ifjcode_form(token.token_value.str);
             printf(" ");
         }
 }
@@ -228,4 +202,4 @@ int print_token_array(Token_T *token_array, int array_length, Parser_T *struct_p
     }
     if(type == 1){printf("\nJUMP if_not_passed%s\nLABEL if_passed%s\n", if_counter, if_counter);}
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
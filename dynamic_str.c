@@ -7,6 +7,7 @@
 
 #include "dynamic_str.h"   // header file
 #include <stdlib.h>        // calloc(), realloc(), free()
+#include <string.h>        // memcpy()
 
 /**
  * Initializes a new dynamic string.
@@ -60,6 +61,38 @@ int append_char_to_str(Dynamic_Str_T *str, char c){
     return DYNAMIC_STR_OK;
 }
 
+/**
+ * Appends a whole span of characters to the end of the string.
+ *
+ * @param str Dynamic string to be appended to 
+ * @param mem The characters to append to the end of the string 
+ * @param n Number of the characters to append
+ * @returns 0 ~ DYNAMIC_STR_OK   — No errors have occured
+ *          1 ~ DYNAMIC_STR_ERR  — An error has occured
+ */
+int append_mem_to_str(Dynamic_Str_T *str, const char *mem, unsigned int n){
+    if (str == NULL || str->dynamic_str == NULL) // The dynamic string pointer is invalid
+        return DYNAMIC_STR_ERR;
+
+    // Allocate more memory if needed (the whole span at once)
+    if (str->str_len + n + 1 > str->bytes_alloc){
+        unsigned int new_size = str->bytes_alloc * 2;
+        if (new_size < str->str_len + n + 1)
+            new_size = str->str_len + n + 1;
+        char *new_str = (char *) realloc(str->dynamic_str, new_size * sizeof(char));
+        if (new_str == NULL) // Realloc failed
+            return DYNAMIC_STR_ERR;
+        str->dynamic_str = new_str;
+        str->bytes_alloc = new_size;
+    }
+
+    // Append the characters and set the correct size values
+    memcpy(str->dynamic_str + str->str_len, mem, n);
+    str->str_len += n;
+    str->dynamic_str[str->str_len] = '\0'; // Add '\0' to the end of the string
+    return DYNAMIC_STR_OK;
+}
+
 /**
  * Cleans all the dynamically allocated memory for the dynamic string. 
  *
@@ -37,6 +37,12 @@ int dynamic_str_init(Dynamic_Str_T *str);
 */
 int append_char_to_str(Dynamic_Str_T *str, char c);
 
+/*
+ * / ***************** append_mem_to_str() ****************** \  
+ * / Function that appends n characters to the end of the string \
+*/
+int append_mem_to_str(Dynamic_Str_T *str, const char *mem, unsigned int n);
+
 /*
  * / ***************************** dynamic_str_clean() ********************************* \  
  * / Function that cleans all the dynamically allocated resources for the dynamic string \
@@ -8,6 +8,7 @@
 
 #include "exp_parser.h"
 #include "exp_stack.h"
+#include "exp_tree.h"
 #include "scanner.h"
 #include "parser.h"
 #include "symtable_stack.h"
@@ -79,75 +80,6 @@ Prec_Table_Symbol_T Token_to_Symbol(Token_T *token){
     }
 }
 
-//operand 1 is the lowest in stack (lowest from those 3 operands)
-Prec_rules_T which_rule(int num_of_operands, Stack_Item_T *operand1, Stack_Item_T *operand2, Stack_Item_T *operand3){
-    if(num_of_operands == 1){
-    	if(operand1->pt_symbol == P_TABLE_ID){
-    	    return RULE_ID;
-    	}
-        return RULE_UNDEFINED;
-    }
-    else if(num_of_operands == 2){
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_EXCL_MARK)){
-            return RULE_NOT_NIL;
-        }
-        return RULE_UNDEFINED;
-    }
-    else if(num_of_operands == 3){
-        // E -> E * E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_MUL) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_MUL;
-        }
-        // E -> E / E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_DIV) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_DIV;
-        }
-        // E -> E + E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_PLUS) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_PLUS;
-        }
-        // E -> E - E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_MINUS) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_MINUS;
-        }
-        // E -> E == E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_EQLS) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_EQ;
-        }
-        // E -> E != E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_NOT_EQLS) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_NOT_EQ;
-        }
-        // E -> E < E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_LESS) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_LESS;
-        }
-        // E -> E > E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_GREATER) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_GREATER;
-        }
-        // E -> E <= E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_LESS_EQL) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_LESS_EQ;
-        }
-        // E -> E >= E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_GREATER_EQL) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_GREATER_EQ;
-        }
-        // E -> E ?? E
-        if((operand1->pt_symbol == P_TABLE_NON_TERMINAL) && (operand2->pt_symbol == P_TABLE_NILL_CMP) && (operand3->pt_symbol == P_TABLE_NON_TERMINAL)) {
-            return RULE_NILL_CMP;
-        }
-        // E -> (E)
-        if((operand1->pt_symbol == P_TABLE_L_PAR) && (operand2->pt_symbol == P_TABLE_NON_TERMINAL) && (operand3->pt_symbol == P_TABLE_R_PAR)) {
-            return RULE_PARS;
-        }
-        return RULE_UNDEFINED;
-    }
-    else{
-    	return RULE_UNDEFINED;
-    }
-}
 enum Var_type which_data_type(Token_T *token, Parser_T *struct_parser){
     switch (token->token_type) {
         case TOKEN_INT:
@@ -158,141 +90,163 @@ enum Var_type which_data_type(Token_T *token, Parser_T *struct_parser){
             return STRING;
         case TOKEN_VAR_ID: ;
             TNode *var_node;
-            var_node = search_st_stack(struct_parser->var_st_stack,token->token_value.dyn_str.dynamic_str);
+            var_node = resolve_symbol(struct_parser, token);
             if(var_node == NULL){
                 return UNDEFINED_TYPE;
             }
-            return var_node->variable_data.type;
+            return var_node->data.variable_data.type;
         default:
             return UNDEFINED_TYPE;
     }
 }
 
-int semantic_analysis(Prec_rules_T rule, Stack_Item_T *operand1, Stack_Item_T *operand2, Stack_Item_T *operand3, enum Var_type *final_type){
+#define St P_TABLE_STOP_REDUCING // Padding of the handles shorter than HANDLE_SIZE
+#define E P_TABLE_NON_TERMINAL
+
+// Rules of precedence table, indexed by Prec_rules_T (adding an operator means adding a row)
+static const Rule_Info_T rule_info[RULE_UNDEFINED] = {
+  /*     handle                                  left right  type check       */
+        {{St, E,  P_TABLE_EXCL_MARK},            1,   1,     TYPES_NOT_NIL},   // E -> E!
+        {{E,  P_TABLE_MUL,         E},           0,   2,     TYPES_ARITHMETIC},// E -> E * E
+        {{E,  P_TABLE_DIV,         E},           0,   2,     TYPES_ARITHMETIC},// E -> E / E
+        {{E,  P_TABLE_PLUS,        E},           0,   2,     TYPES_PLUS},      // E -> E + E
+        {{E,  P_TABLE_MINUS,       E},           0,   2,     TYPES_ARITHMETIC},// E -> E - E
+        {{E,  P_TABLE_EQLS,        E},           0,   2,     TYPES_EQUALITY},  // E -> E == E
+        {{E,  P_TABLE_NOT_EQLS,    E},           0,   2,     TYPES_EQUALITY},  // E -> E != E
+        {{E,  P_TABLE_LESS,        E},           0,   2,     TYPES_RELATION},  // E -> E < E
+        {{E,  P_TABLE_GREATER,     E},           0,   2,     TYPES_RELATION},  // E -> E > E
+        {{E,  P_TABLE_LESS_EQL,    E},           0,   2,     TYPES_RELATION},  // E -> E <= E
+        {{E,  P_TABLE_GREATER_EQL, E},           0,   2,     TYPES_RELATION},  // E -> E >= E
+        {{E,  P_TABLE_NILL_CMP,    E},           0,   2,     TYPES_NILL_CMP},  // E -> E ?? E
+        {{P_TABLE_L_PAR, E, P_TABLE_R_PAR},      1,   1,     TYPES_PARS},      // E -> (E)
+        {{St, St, P_TABLE_ID},                   2,   2,     TYPES_ID},        // E -> id
+};
 
-    if(rule != RULE_ID && rule != RULE_PARS && rule != RULE_NOT_NIL) {
-        if((operand1->data_type == UNDEFINED_TYPE) || (operand3->data_type == UNDEFINED_TYPE)){
-            return SEMANTIC_ERR_C;}
+#undef St
+#undef E
 
-        if((operand1->data_type == BOOL) || (operand3->data_type == BOOL)){
-            return SEMANTIC_ERR_E;}
-    }
+// Rule of each handle, indexed by its symbols (computed from rule_info)
+static unsigned char rule_table[P_TABLE_SYMBOLS][P_TABLE_SYMBOLS][P_TABLE_SYMBOLS];
 
-    switch (rule) {
-        case RULE_NOT_NIL:
-            if(operand1->data_type == UNDEFINED_TYPE){
-                return SEMANTIC_ERR_C;}
-            if(operand1->token == NULL){
-                return SEMANTIC_ERR_E;
-            }
-            if(operand1->token->token_value.token_keyword == NIL_KW) {
-                return SEMANTIC_ERR_E;}
-            break;
+// Type of the result of each rule, indexed by the rule and the classes of its operands (computed from rule_info)
+static Type_Result_T type_table[RULE_UNDEFINED][OPERAND_CLASSES][OPERAND_CLASSES];
 
-        case RULE_MUL:
-        case RULE_PLUS:
-        case RULE_MINUS:
-            if(operand1->data_type == INT && operand3->data_type == INT ){
-                *final_type = INT;}
-            else if(operand1->data_type == DOUBLE && operand3->data_type == DOUBLE ){
-                *final_type = DOUBLE;}
-            else if(operand1->data_type == DOUBLE && operand3->data_type == INT ){
-                if(operand3->token == NULL){
-                    return SEMANTIC_ERR_E;
-                }
-                if(operand3->token->token_type == TOKEN_INT){
-                    //IntToDouble(operand3)
-                    *final_type = DOUBLE;
-                    break;
-                }
-                return SEMANTIC_ERR_E;}
-            else if(operand1->data_type == INT && operand3->data_type == DOUBLE ){
-                if(operand1->token == NULL){
-                    return SEMANTIC_ERR_E;
-                }
-                if(operand1->token->token_type == TOKEN_INT){
-                    //IntToDouble(operand1)
-                    *final_type = DOUBLE;
-                    break;
-                }
-                return SEMANTIC_ERR_E;}
-            //concatenate
-            else if (operand1->data_type == STRING && operand2->pt_symbol == P_TABLE_PLUS && operand3->data_type == STRING){
-                *final_type = STRING;
-            }
-            else if(operand1->data_type != operand3->data_type){
-                return SEMANTIC_ERR_E;}
-            break;
+//data type of the operand class (literals are Int / Double)
+static enum Var_type class_type(Operand_Class_T operand_class){
+    if(operand_class == OPERAND_INT_LITERAL){
+        return INT;}
+    if(operand_class == OPERAND_DOUBLE_LITERAL){
+        return DOUBLE;}
+    return (enum Var_type)operand_class;
+}
 
-        case RULE_DIV:
-            if(operand1->data_type == INT && operand3->data_type == INT ){
-                *final_type = INT;}
-            else if(operand1->data_type == DOUBLE && operand3->data_type == DOUBLE ){
-                *final_type = DOUBLE;}
-            break;
+//class of the stack item, only literals of numbers hold their token after a reduction
+static Operand_Class_T operand_class(Stack_Item_T *operand){
+    if(operand->has_token && operand->token_type == TOKEN_INT){
+        return OPERAND_INT_LITERAL;}
+    if(operand->has_token && operand->token_type == TOKEN_FLOAT){
+        return OPERAND_DOUBLE_LITERAL;}
+    return (Operand_Class_T)operand->data_type;
+}
 
-        //rel. operators
-        case RULE_EQ:
-        case RULE_NOT_EQ:
-            *final_type = BOOL;
-            if(operand1->data_type == INT && operand3->data_type == DOUBLE){
-                //IntToDouble(operand1)
-                break;
-            }
-            else if(operand1->data_type == INT && operand3->data_type == DOUBLE){
-                //IntToDouble(operand3)
-                break;
-            }
-            else if(operand1->data_type != operand3->data_type){
-                return SEMANTIC_ERR_E;}
-            break;
+//sets the result of the type checking
+static Type_Result_T type_result(enum Var_type type, int error){
+    Type_Result_T result;
+    result.type = (unsigned char)type;
+    result.error = (unsigned char)error;
+    return result;
+}
 
-        case RULE_LESS:
-        case RULE_GREATER:
-        case RULE_LESS_EQ:
-        case RULE_GREATER_EQ:
-            *final_type = BOOL;
-            if(operand1->data_type != operand3->data_type){
-                return SEMANTIC_ERR_E;}
-            break;
+//checks the types of the operands of one rule, it's used only to fill the type table
+//(literals of numbers are never nil)
+static Type_Result_T check_types(Type_Check_T check, Operand_Class_T left, Operand_Class_T right){
+    enum Var_type type1 = class_type(left);
+    enum Var_type type3 = class_type(right);
+    bool literal1 = (left == OPERAND_INT_LITERAL || left == OPERAND_DOUBLE_LITERAL);
+
+    switch (check) {
+        case TYPES_NOT_NIL:
+            if(type1 == UNDEFINED_TYPE){
+                return type_result(type1, SEMANTIC_ERR_C);}
+            if(!literal1){
+                return type_result(type1, SEMANTIC_ERR_E);}
+            return type_result(type1, NO_ERR);
+
+        case TYPES_PARS:
+            if(type1 == UNDEFINED_TYPE){
+                return type_result(type1, SEMANTIC_ERR_C);}
+            return type_result(type1, NO_ERR);
+
+        case TYPES_ID:
+            if(type1 == UNDEFINED_TYPE){
+                return type_result(type1, SEMANTIC_ERR_C);}
+            if(type1 == BOOL){
+                return type_result(type1, SEMANTIC_ERR_E);}
+            return type_result(type1, NO_ERR);
 
-        case RULE_NILL_CMP:
-            if(operand1->data_type == UNDEFINED_TYPE || operand3->data_type == UNDEFINED_TYPE){
-                return SEMANTIC_ERR_E;
-            }
-            if(operand1->token == NULL){
-                return SEMANTIC_ERR_E;
-            }
-            if(operand1->token->token_value.token_keyword == NIL_KW){
-                if((operand3->data_type == INT && operand1->data_type == INT_NIL) ||
-                   (operand3->data_type == DOUBLE && operand1->data_type == DOUBLE_NIL) ||
-                   (operand3->data_type == STRING && operand1->data_type ==STRING_NIL))
-                    break;
-                else{
-                    return SEMANTIC_ERR_E;
-                }
-            }
+        default:
             break;
+    }
 
-        case RULE_PARS:
-            if(operand2->data_type == UNDEFINED_TYPE){
-                return SEMANTIC_ERR_C;}
+    //binary operators
+    if((type1 == UNDEFINED_TYPE) || (type3 == UNDEFINED_TYPE)){
+        return type_result(UNDEFINED_TYPE, SEMANTIC_ERR_C);}
+    if((type1 == BOOL) || (type3 == BOOL)){
+        return type_result(UNDEFINED_TYPE, SEMANTIC_ERR_E);}
+
+    switch (check) {
+        case TYPES_PLUS:
+            //concatenation of strings
+            if(type1 == STRING && type3 == STRING){
+                return type_result(STRING, NO_ERR);}
+            /* FALLTHROUGH */
+        case TYPES_ARITHMETIC:
+            //IntToDouble of the Int literal
+            if(type1 == DOUBLE && type3 == INT){
+                return type_result(DOUBLE, (right == OPERAND_INT_LITERAL) ? NO_ERR : SEMANTIC_ERR_E);}
+            if(type1 == INT && type3 == DOUBLE){
+                return type_result(DOUBLE, (left == OPERAND_INT_LITERAL) ? NO_ERR : SEMANTIC_ERR_E);}
+            //Int and Double only (nil can't be used either)
+            if(type1 != type3 || (type1 != INT && type1 != DOUBLE)){
+                return type_result(type1, SEMANTIC_ERR_E);}
+            return type_result(type1, NO_ERR);
+
+        case TYPES_EQUALITY:
+            if(type1 == INT && type3 == DOUBLE){
+                //IntToDouble(operand1)
+                return type_result(BOOL, NO_ERR);}
+            return type_result(BOOL, (type1 != type3) ? SEMANTIC_ERR_E : NO_ERR);
 
-            *final_type = operand2->data_type;
-            break;
+        case TYPES_RELATION:
+            return type_result(BOOL, (type1 != type3) ? SEMANTIC_ERR_E : NO_ERR);
 
-        case RULE_ID:
-            if(operand1->data_type == UNDEFINED_TYPE){
-                return SEMANTIC_ERR_C;}
-            if(operand1->data_type == BOOL){
-                return SEMANTIC_ERR_E;}
-            *final_type = operand1->data_type;
-            break;
+        case TYPES_NILL_CMP:
+            if(!literal1){
+                return type_result(type1, SEMANTIC_ERR_E);}
+            return type_result(type1, NO_ERR);
 
         default:
-            break;
+            return type_result(UNDEFINED_TYPE, SEMANTIC_ERR_E);
     }
-    return NO_ERR;
+}
+
+//fills the rule and type tables from rule_info, it's done only once
+static void init_reduce_tables(){
+    static bool tables_ready = false;
+    if(tables_ready){
+        return;}
+
+    memset(rule_table, RULE_UNDEFINED, sizeof(rule_table));
+    for(int rule = 0; rule < RULE_UNDEFINED; rule++){
+        const Rule_Info_T *info = &rule_info[rule];
+        rule_table[info->handle[0]][info->handle[1]][info->handle[2]] = (unsigned char)rule;
+        for(int left = 0; left < OPERAND_CLASSES; left++){
+            for(int right = 0; right < OPERAND_CLASSES; right++){
+                type_table[rule][left][right] = check_types(info->check, (Operand_Class_T)left, (Operand_Class_T)right);
+            }
+        }
+    }
+    tables_ready = true;
 }
 
 int shift_to_stack(Stack_T *stack, Token_T *token, Parser_T *struct_parser){
@@ -306,122 +260,103 @@ int shift_to_stack(Stack_T *stack, Token_T *token, Parser_T *struct_parser){
         return 99;
     }
     
-    // Push values on stack
-    if (token->token_type == TOKEN_INT){
-            printf("PUSHS int@%d\n", token->token_value.num_integer);
-    } else if (token->token_type == TOKEN_FLOAT){
-            printf("PUSHS float@%a\n", token->token_value.num_decimal);
-    } else if (token->token_type == TOKEN_STR){
-            printf("PUSHS string@");
-            print_string_in_ifjcode_form(token->token_value.dyn_str.dynamic_str);
-            printf("\n");
-    } else if (token->token_type == TOKEN_VAR_ID){
-        if (struct_parser->inside_main == true || struct_parser->in_while == true)
-            printf("PUSHS GF@__%s__\n", token->token_value.dyn_str.dynamic_str);
-        else
-            printf("PUSHS LF@__%s__\n", token->token_value.dyn_str.dynamic_str);
-    }   
-    
+    //literals and variables are leaves of the expression tree, the code is printed after the whole expression is parsed
+    if (token_symbol == P_TABLE_ID){
+        bool global = (struct_parser->inside_main == true || struct_parser->in_while == true);
+        int node = exp_tree_leaf(struct_parser->exp_tree, token, stack_item(stack, 0)->data_type, global);
+        if (node == -1){
+            return 99;
+        }
+        stack_item(stack, 0)->node = node;
+    }
+
     return NO_ERR;
 }
 
-int reduce(Stack_T *stack){
-    Stack_Item_T *operand1 = NULL;
-    Stack_Item_T *operand2 = NULL;
-    Stack_Item_T *operand3 = NULL;
-    Prec_rules_T rule;
-    int error;
-    enum Var_type final_type;
+int reduce(Stack_T *stack, Exp_Tree_T *tree){
     int after_stop_reduce = stack_items_after_stop_reducing(stack);
-    switch (after_stop_reduce) {
-        case 1:
-            //one operand to reduce
-            operand1 = stack->stack_head;
-            if((rule = which_rule(1, operand1, operand2, operand3)) == RULE_UNDEFINED){
-                return SYNTAX_ERR;}
-
-            //pop two items, bcs I need to remove the stop_reduce symbol too
-            //semantic analysis, if error, return to main parser function and end program
-            if((error = semantic_analysis(rule, operand1, operand2, operand3, &final_type)) != NO_ERR){
-                return error;
-            }
-            stack_pop_item_multi(stack,2);
-            //Operand is literal, so I will pass the token to non_terminal that represents this number
-            //this will be usefull for semantic checks in reduce_function
-            if(operand1->token->token_type == TOKEN_INT || operand1->token->token_type == TOKEN_FLOAT){
-                stack_push_item(stack, P_TABLE_NON_TERMINAL, final_type, operand1->token);
-                break;}
-
-            stack_push_item(stack, P_TABLE_NON_TERMINAL, final_type, NULL);
-            break;
-        case 2:
-            //two operands to reduce
-            operand1 = stack->stack_head->next_item;
-            operand2 = stack->stack_head;
-            if((rule = which_rule(2, operand1, operand2, operand3)) == RULE_UNDEFINED){
-                return SYNTAX_ERR;}
-
-            //semantic analysis, if error, return to main parser function and end program
-            if((error = semantic_analysis(rule, operand1, operand2, operand3, &final_type)) != NO_ERR){
-                return error;}
-
-            stack_pop_item_multi(stack,3);
-            stack_push_item(stack, P_TABLE_NON_TERMINAL, final_type, NULL);
-            break;
-        case 3:
-            //three operands to reduce
-            operand1 = stack->stack_head->next_item->next_item;
-            operand2 = stack->stack_head->next_item;
-            operand3 = stack->stack_head;
-            if((rule = which_rule(3, operand1, operand2, operand3)) == RULE_UNDEFINED){
-                return SYNTAX_ERR;}
-            //semantic analysis, if error, return to main parser function and end program
-            if((error = semantic_analysis(rule, operand1, operand2, operand3, &final_type)) != NO_ERR){
-                return error;}
-            // Apply arithmetic operations to values on stack
-            if (rule == RULE_MUL){
-                printf("MULS\n");
-            }
-            else if (rule == RULE_DIV){
-                if (operand3->token->token_type == TOKEN_FLOAT){
-                    printf("DIVS\n");
-                }
-                else if (operand3->token->token_type == TOKEN_INT){
-                    printf("IDIVS\n");
-                }
-            }
-            else if (rule == RULE_PLUS){
-                printf("ADDS\n");
-            }
-            else if (rule == RULE_MINUS){
-                printf("SUBS\n");
-            }
+    if(after_stop_reduce < 1 || after_stop_reduce > HANDLE_SIZE){
+        return SYNTAX_ERR;}
+
+    //handle[0] is the lowest in stack, shorter handles start with stop_reduce symbols (as in rule_info)
+    Stack_Item_T *handle[HANDLE_SIZE] = {NULL, NULL, NULL};
+    Prec_Table_Symbol_T symbols[HANDLE_SIZE] = {P_TABLE_STOP_REDUCING, P_TABLE_STOP_REDUCING, P_TABLE_STOP_REDUCING};
+    for(int i = 0; i < after_stop_reduce; i++){
+        handle[HANDLE_SIZE - 1 - i] = stack_item(stack, i);
+        symbols[HANDLE_SIZE - 1 - i] = handle[HANDLE_SIZE - 1 - i]->pt_symbol;
+    }
 
-            stack_pop_item_multi(stack,4);
+    //the rule of the handle and the type of its result are looked up in the tables
+    Prec_rules_T rule = (Prec_rules_T)rule_table[symbols[0]][symbols[1]][symbols[2]];
+    if(rule == RULE_UNDEFINED){
+        return SYNTAX_ERR;}
+    Stack_Item_T *left = handle[rule_info[rule].left];
+    Stack_Item_T *right = handle[rule_info[rule].right];
+    Type_Result_T result = type_table[rule][operand_class(left)][operand_class(right)];
+    //semantic analysis, if error, return to main parser function and end program
+    if(result.error != NO_ERR){
+        return result.error;}
+    enum Var_type final_type = (enum Var_type)result.type;
+
+    //the operands are replaced by the node of the rule (unary rules stand for their operand)
+    int node = left->node;
+    if (left != right){
+        if ((node = exp_tree_binary(tree, rule, final_type, left->node, right->node)) == -1){
+            return COMPILER_ERR_INTER;}
+    }
 
-            stack_push_item(stack, P_TABLE_NON_TERMINAL, final_type, NULL);
-            break;
-        default:
-            return SYNTAX_ERR;
+    //pop the handle and the stop_reduce symbol too
+    //popped items stay in the memory of the stack until the next push, so left can still be read
+    stack_pop_item_multi(stack, after_stop_reduce + 1);
+    //Operand is literal, so I will pass the token to non_terminal that represents this number
+    //this will be usefull for semantic checks of the next reductions
+    if(rule == RULE_ID && left->has_token && (left->token_type == TOKEN_INT || left->token_type == TOKEN_FLOAT)){
+        Token_T literal;
+        literal.token_type = left->token_type;
+        stack_push_item(stack, P_TABLE_NON_TERMINAL, final_type, &literal);
     }
+    else{
+        stack_push_item(stack, P_TABLE_NON_TERMINAL, final_type, NULL);
+    }
+    stack_item(stack, 0)->node = node;
     return NO_ERR;
 }
 
 int expression_parse(Parser_T *struct_parser) {
     int result;
-    Stack_T *stack = stack_init();
-    if(stack == NULL){ return 99; }
+    //the stack and the tree belong to the parser, they are created by the first expression and reused by the others
+    if(struct_parser->exp_stack == NULL){
+        struct_parser->exp_stack = stack_init();
+        if(struct_parser->exp_stack == NULL){ return 99; }
+    }
+    if(struct_parser->exp_tree == NULL){
+        struct_parser->exp_tree = exp_tree_init();
+        if(struct_parser->exp_tree == NULL){ return 99; }
+    }
+    Stack_T *stack = struct_parser->exp_stack;
+#ifndef EXP_STACK_CODE
+    //the destination is only valid for this expression
+    char *dest = struct_parser->exp_dest;
+    bool dest_global = (struct_parser->inside_main == true || struct_parser->in_while == true);
+    struct_parser->exp_dest = NULL;
+    //the temporary variables belong to the function being parsed (its body isn't interrupted by another one)
+    if(struct_parser->exp_tree->pools[struct_parser->exp_tree->pool].func != struct_parser->current_func_name){
+        if(exp_tree_pool(struct_parser->exp_tree, struct_parser->current_func_name) != NO_ERR){ return 99; }
+    }
+#endif
+    struct_parser->exp_assigned = false;
+    init_reduce_tables();
+    //some errors return without cleaning the stack, so start with an empty one
+    stack_clean(stack);
+    exp_tree_clean(struct_parser->exp_tree);
     //at beginning, push dollar on bottom of stack
     if ((stack_push_item(stack, P_TABLE_DOLLAR, UNDEFINED_TYPE, NULL) == false)) {
         stack_clean(stack); return 99;
     }
     int error;
     Token_T *token = &struct_parser->current_token;
-    //if we are in assignment rule, it is possible that current token sent from parser struct,
-    //is already a part of an expression
-    if(struct_parser->call_new_token == true) {
-        TOKEN_OR_STACKCLEAN(token, stack)
-    }
+    //the expression starts with the next token (the parser decides with token_stream_peek() / peek_token())
+    TOKEN_OR_STACKCLEAN(token, stack)
 
     //special part for "nil" in expression
     if(token->token_value.token_keyword == NIL_KW) {
@@ -435,6 +370,13 @@ int expression_parse(Parser_T *struct_parser) {
             struct_parser->var_data->type == DOUBLE_NIL){
                 TOKEN_OR_STACKCLEAN(token,stack)
                 struct_parser->current_token = *token;
+#ifndef EXP_STACK_CODE
+                if(dest != NULL){
+                    printf("MOVE %s@__%s__ nil@nil\n", dest_global ? "GF" : "LF", dest);
+                    struct_parser->exp_assigned = true;
+                    return NO_ERR;
+                }
+#endif
                 printf("PUSHS nil@nil\n");
                 return NO_ERR;
             }
@@ -462,9 +404,9 @@ int expression_parse(Parser_T *struct_parser) {
 
             Prec_Table_Symbol_T symbol = Token_to_Symbol(token);
             if (symbol == P_TABLE_ID) {
-                TNode *var_node = search_st_stack(struct_parser->var_st_stack,token->token_value.dyn_str.dynamic_str);
-                if(var_node->variable_data.init == true){}
-                if(var_node->variable_data.constant == false){
+                TNode *var_node = resolve_symbol(struct_parser, token);
+                if(var_node->data.variable_data.init == true){}
+                if(var_node->data.variable_data.constant == false){
                     return SEMANTIC_ERR_OTHER;
                 }
                 TOKEN_OR_STACKCLEAN(token, stack)
@@ -542,8 +484,7 @@ int expression_parse(Parser_T *struct_parser) {
 
             case S: ;
                 //shift item to stack and insert stop_reduce
-                Token_T tmp = *token;
-                if((error = shift_to_stack(stack, &tmp, struct_parser)) != NO_ERR){
+                if((error = shift_to_stack(stack, token, struct_parser)) != NO_ERR){
                     stack_clean(stack); return error;
                 }
                 TOKEN_OR_STACKCLEAN(token,stack)
@@ -552,15 +493,14 @@ int expression_parse(Parser_T *struct_parser) {
 
             case R:
                 //reduce expressions with one of the rules
-                if((error = reduce(stack)) != NO_ERR){
+                if((error = reduce(stack, struct_parser->exp_tree)) != NO_ERR){
                     stack_clean(stack); return error;
                 }
                 break;
 
             case Eq: ;
                 //Pars are complet/closed, just push item to stack
-                Token_T tmp2 = *token;
-                if(!stack_push_item(stack, token_symbol, which_data_type(&tmp2, struct_parser), &tmp2)){
+                if(!stack_push_item(stack, token_symbol, which_data_type(token, struct_parser), token)){
                     stack_clean(stack); return 99;}
                 TOKEN_OR_STACKCLEAN(token,stack)
                 break;
@@ -583,8 +523,8 @@ int expression_parse(Parser_T *struct_parser) {
                 TOKEN_OR_STACKCLEAN(token,stack)
                 Prec_Table_Symbol_T symbol = Token_to_Symbol(token);
                 if (symbol == P_TABLE_ID){
-                    TNode *var_node = search_st_stack(struct_parser->var_st_stack,token->token_value.dyn_str.dynamic_str);
-                    if(var_node->variable_data.constant == false){
+                    TNode *var_node = resolve_symbol(struct_parser, token);
+                    if(var_node->data.variable_data.constant == false){
                         return SEMANTIC_ERR_OTHER;
                     }
                     TOKEN_OR_STACKCLEAN(token,stack)
@@ -595,11 +535,25 @@ int expression_parse(Parser_T *struct_parser) {
                 else{
                     return SYNTAX_ERR;}}}
     }
-    if(stack->stack_head->pt_symbol != P_TABLE_NON_TERMINAL){
+    if(stack_item(stack, 0)->pt_symbol != P_TABLE_NON_TERMINAL){
         stack_clean(stack);
         return SYNTAX_ERR;
     }
-    enum Var_type return_type = stack->stack_head->data_type;
+    //the code of the whole expression is printed at once, constant parts of it are folded already
+    //(conditions of if / while are printed from token_array, their value isn't pushed)
+    if(struct_parser->current_rule != IF_STMNT && struct_parser->current_rule != WHILE_STMNT){
+#ifndef EXP_STACK_CODE
+        //three-address code, the value goes straight to the destination variable if there is one
+        error = exp_tree_emit_tac(struct_parser->exp_tree, stack_item(stack, 0)->node, dest, dest_global);
+        struct_parser->exp_assigned = (dest != NULL);
+#else
+        error = exp_tree_emit(struct_parser->exp_tree, stack_item(stack, 0)->node);
+#endif
+        if(error != NO_ERR){
+            stack_clean(stack); return error;
+        }
+    }
+    enum Var_type return_type = stack_item(stack, 0)->data_type;
     if(struct_parser->current_rule == VAR_DEF) {
         if (struct_parser->var_data->type == UNDEFINED_TYPE) {
             struct_parser->var_data->type = return_type;
@@ -626,19 +580,19 @@ int expression_parse(Parser_T *struct_parser) {
     //check of return type
     if(struct_parser->current_rule == RETURN) {
         printf("CREATEFRAME\n");
-        TNode *found = search_symbol(struct_parser->global_func_symbtable->root, struct_parser->current_func_name);
-        enum Var_type wanted_return = found->function_data.ret_type;
+        TNode *found = search_symbol(struct_parser->global_func_symbtable, struct_parser->current_func_name);
+        enum Var_type wanted_return = found->data.function_data.ret_type;
         switch (wanted_return) {
             case INT:
-                if (stack->stack_head->data_type != INT) {
+                if (stack_item(stack, 0)->data_type != INT) {
                     return SEMANTIC_ERR_B;}
                 break;
             case DOUBLE:
-                if (stack->stack_head->data_type != DOUBLE) {
+                if (stack_item(stack, 0)->data_type != DOUBLE) {
                     return SEMANTIC_ERR_B;}
                 break;
             case STRING:
-                if (stack->stack_head->data_type != STRING) {
+                if (stack_item(stack, 0)->data_type != STRING) {
                     return SEMANTIC_ERR_B;}
                 break;
             default:
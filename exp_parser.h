@@ -16,7 +16,7 @@
 #define PREC_TABLE_SIZE 16 // Size of the precedence table (column x row ~ 16 x 16)
 
 #define TOKEN_OR_STACKCLEAN(token,stack) \
-    result = skip_EOL(token);            \
+    result = next_token(token);          \
     if (result != NO_ERR){               \
         stack_clean(stack);              \
         return result;}
@@ -95,6 +95,59 @@ typedef enum Prec_rules {
 }Prec_rules_T;
 
 
+// Number of the symbols that can be stored in the stack (precedence table symbols, E and stop_reduce)
+#define P_TABLE_SYMBOLS (P_TABLE_STOP_REDUCING + 1)
+
+// Length of the longest handle (E -> E op E, E -> (E))
+#define HANDLE_SIZE 3
+
+/*
+ * / ********************* Operand_Class_T ********************* \
+ * / Enum that holds the classes of the operands for type checking \
+ * / (a class is the data type, literals of numbers have their own) \
+*/
+typedef enum Operand_Class {
+    OPERAND_INT_LITERAL = VOID + 1,     // Int literal (can be converted to Double)
+    OPERAND_DOUBLE_LITERAL,             // Double literal
+    OPERAND_CLASSES                     // Number of the classes (enum Var_type values come first)
+} Operand_Class_T;
+
+/*
+ * / ********************** Type_Check_T ********************** \
+ * / Enum that holds the ways of checking the types of operands  \
+*/
+typedef enum Type_Check {
+    TYPES_ARITHMETIC,   // *, /, - (Int / Double, Int literal can be used as Double)
+    TYPES_PLUS,         // + (as TYPES_ARITHMETIC, it also concatenates strings)
+    TYPES_EQUALITY,     // ==, != (Int can be compared with Double)
+    TYPES_RELATION,     // <, >, <=, >= (same types only)
+    TYPES_NILL_CMP,     // ?? (left operand has to be a literal)
+    TYPES_NOT_NIL,      // E! (operand has to be a literal)
+    TYPES_PARS,         // (E) (type of the operand)
+    TYPES_ID            // id (type of the operand, Bool can't be used)
+} Type_Check_T;
+
+/*
+ * / ************************ Rule_Info_T ************************ \
+ * / Struct that describes one rule of precedence table (a row of  \
+ * / the rules table, the reduce tables are computed from the rows) \
+*/
+typedef struct Rule_Info {
+    Prec_Table_Symbol_T handle[HANDLE_SIZE];  // Symbols of the handle (shorter handles start with stop_reduce symbols)
+    int left;                                 // Position of the left operand in the handle
+    int right;                                // Position of the right operand in the handle (same as left ~ one operand)
+    Type_Check_T check;                       // How the types of the operands are checked
+} Rule_Info_T;
+
+/*
+ * / ********************** Type_Result_T ********************** \
+ * / Struct that holds the result of type checking of one rule    \
+*/
+typedef struct Type_Result {
+    unsigned char type;     // Type of the reduced expression (enum Var_type)
+    unsigned char error;    // Error of the types of the operands (NO_ERR ~ the types are correct)
+} Type_Result_T;
+
 /*
  * / ****************** Token_to_Symbol() ******************* \  
  * / Function that converts token in to the Prec. table symbol\
@@ -10,125 +10,147 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+//checks if the symbol is a terminal (the symbols of the precedence table)
+static bool is_terminal(Prec_Table_Symbol_T pt_symbol){
+    return (pt_symbol != P_TABLE_NON_TERMINAL)&&(pt_symbol != P_TABLE_STOP_REDUCING);
+}
+
+//makes room for one more item, the stack is allocated only when it gets deeper than ever before
+static bool stack_reserve(Stack_T *stack){
+    if(stack->count < stack->capacity){
+        return true;
+    }
+    int capacity = (stack->capacity == 0) ? STACK_SIZE : stack->capacity * 2;
+    Stack_Item_T *items = realloc(stack->items, capacity * sizeof(Stack_Item_T));
+    if(items == NULL){
+        return false;
+    }
+    stack->items = items;
+    stack->capacity = capacity;
+    return true;
+}
+
+//fills the item and links it with the terminal / stop_reduce item below
+static void stack_set_item(Stack_T *stack, int index, Prec_Table_Symbol_T pt_symbol, enum Var_type data_type, Token_T *token){
+    Stack_Item_T *item = &stack->items[index];
+    item->pt_symbol = pt_symbol;
+    item->data_type = data_type;
+    item->below = -1;
+    item->node = -1;
+    item->has_token = (token != NULL);
+    if(token != NULL){
+        item->token_type = token->token_type; // Only the type is needed by the reductions, the token isn't copied
+    }
+    if(is_terminal(pt_symbol)){
+        item->below = stack->top_terminal;
+        stack->top_terminal = index;
+    }
+    else if(pt_symbol == P_TABLE_STOP_REDUCING){
+        item->below = stack->last_stop;
+        stack->last_stop = index;
+    }
+}
+
 Stack_T* stack_init() {
     Stack_T *stack = malloc(sizeof (Stack_T));
     if(stack == NULL){
         return NULL;
     }
-    stack->stack_head = NULL;
+    stack->items = NULL;
+    stack->count = 0;
+    stack->capacity = 0;
+    stack->top_terminal = -1;
+    stack->last_stop = -1;
     return stack;
 }
 
 bool stack_push_item(Stack_T *stack, Prec_Table_Symbol_T pt_symbol, enum Var_type data_type, Token_T *token){
-    Stack_Item_T *new_item = malloc(sizeof(Stack_Item_T));
-    if(new_item == NULL){
+    if(!stack_reserve(stack)){
         return false;
     }
     //insert data about new_item push
-    new_item->next_item = stack->stack_head;
-    new_item->data_type = data_type;
-    new_item->pt_symbol = pt_symbol;
-    new_item->token = token;
-    stack->stack_head = new_item;
+    stack_set_item(stack, stack->count, pt_symbol, data_type, token);
+    stack->count++;
     return true;
 }
 
 void stack_pop_item(Stack_T *stack){
     //if stack is not empty...
-    if(stack->stack_head != NULL){
-        Stack_Item_T *tmp_del_item = stack->stack_head;
-        stack->stack_head = stack->stack_head->next_item;
-        free(tmp_del_item);
+    if(stack->count != 0){
+        int index = --stack->count;
+        //the terminal / stop_reduce item below is the closest to the top now
+        if(index == stack->top_terminal){
+            stack->top_terminal = stack->items[index].below;
+        }
+        else if(index == stack->last_stop){
+            stack->last_stop = stack->items[index].below;
+        }
     }
 }
 
 void stack_clean(Stack_T *stack) {
-    //deleting items until stack_head is NULL
-    while(true) {
-        if (stack->stack_head != NULL) {
-            stack_pop_item(stack);
-        }
-        else{
-            break;
-        }
+    //deleting all the items at once, the memory stays for the next expression
+    stack->count = 0;
+    stack->top_terminal = -1;
+    stack->last_stop = -1;
+}
+
+void stack_dispose(Stack_T *stack) {
+    if(stack != NULL){
+        free(stack->items);
+        free(stack);
     }
-    free(stack);
 }
 
 void stack_pop_item_multi(Stack_T *stack, int how_many){
     while(how_many != 0) {
-        if (stack->stack_head != NULL) {
-            Stack_Item_T *tmp_del_item = stack->stack_head;
-            stack->stack_head = stack->stack_head->next_item;
-            free(tmp_del_item);
-        }
+        stack_pop_item(stack);
         how_many--;
     }
 }
 
 Stack_Item_T* stack_first_terminal(Stack_T *stack){
-    Stack_Item_T *current_item = stack->stack_head;
-    while(current_item != NULL) {
-        if ((current_item->pt_symbol != P_TABLE_NON_TERMINAL)&&(current_item->pt_symbol != P_TABLE_STOP_REDUCING)){
-            return current_item;
-        }
-        else{
-            current_item = current_item->next_item;
-        }
+    if(stack->top_terminal == -1){
+        return NULL;
+    }
+    return &stack->items[stack->top_terminal];
+}
+
+Stack_Item_T* stack_item(Stack_T *stack, int depth){
+    if(depth < 0 || depth >= stack->count){
+        return NULL;
     }
-    return NULL;
+    return &stack->items[stack->count - 1 - depth];
 }
 
 bool stack_push_item_after_top_terminal(Stack_T *stack, Prec_Table_Symbol_T pt_symbol, enum Var_type data_type, Token_T *token){
-    Stack_Item_T *prev_item = NULL;
-    Stack_Item_T *current_item = stack->stack_head;
-    while(current_item != NULL){
-        if ((current_item->pt_symbol != P_TABLE_NON_TERMINAL)&&(current_item->pt_symbol != P_TABLE_STOP_REDUCING)){
-            //NON_terminal found
-            //no upper items in stack
-            if(prev_item == NULL){
-                stack_push_item(stack, pt_symbol, data_type, token);
-                return true;
-            }
-            //not top_stack item
-            else{
-                Stack_Item_T *new_item = malloc(sizeof(Stack_Item_T));
-                new_item->pt_symbol = pt_symbol;
-                new_item->data_type = data_type;
-                new_item->token = token;
-                //insert new item between Terminal and another item
-                prev_item->next_item = new_item;
-                new_item->next_item = current_item;
-                return true;
-            }
-        }
-        prev_item = current_item;
-        current_item = current_item->next_item;
+    if(stack->top_terminal == -1){
+        return false;
+    }
+    if(!stack_reserve(stack)){
+        return false;
+    }
+    //only non_terminals are above the top terminal (a stop_reduce item is always followed by a terminal),
+    //so the moved items don't have to be relinked, there is at most one of them
+    int index = stack->top_terminal + 1;
+    for(int i = stack->count; i > index; i--){
+        stack->items[i] = stack->items[i - 1];
     }
-    return false;
+    stack->count++;
+    //insert new item between Terminal and another item
+    stack_set_item(stack, index, pt_symbol, data_type, token);
+    return true;
 }
 
 int stack_items_after_stop_reducing(Stack_T *stack){
-    Stack_Item_T *current_item = stack->stack_head;
-    int count = 0;
-    while(current_item != NULL){
-        if(current_item->pt_symbol == P_TABLE_STOP_REDUCING){
-            return count;
-        }
-        count++;
-        current_item = current_item->next_item;
-    }
-    return count;
+    //without stop_reduce item all the items are counted
+    return stack->count - 1 - stack->last_stop;
 }
 
 void print_stack(Stack_T *stack){
-    Stack_Item_T *item = stack->stack_head;
-    int i=0;
     printf("stacktop->");
-    do {
-        printf("%d:%d ", i, item->pt_symbol);
-        i++;
-        item = item->next_item;
-    }while(item != NULL);
+    for(int i = 0; i < stack->count; i++){
+        printf("%d:%d ", i, stack->items[stack->count - 1 - i].pt_symbol);
+    }
 }
 
@@ -17,17 +17,33 @@
 typedef struct StackItem {
     Prec_Table_Symbol_T pt_symbol;
     enum Var_type data_type;
-    struct StackItem *next_item;
-    Token_T *token;
+    int below;          // Index of the terminal / stop_reduce item below (terminals and stop_reduce items only, -1 ~ none)
+    int node;           // Node of the expression tree the item stands for (-1 ~ none)
+    bool has_token;     // Indicates if the item was made of a token or not
+    Token_Type_T token_type; // Type of the token the item was made of (set only if has_token)
 } Stack_Item_T;
 
+/*
+ * The stack is one array of items (the top one is the last), it belongs to the parser
+ * and its memory is reused by all the expressions, so pushing and popping never allocates
+ * The terminal and the stop_reduce item closest to the top are tracked by their indices
+ * (every terminal / stop_reduce item links the previous one), so no operation walks the stack
+ */
 typedef struct Stack {
-    Stack_Item_T *stack_head;
+    Stack_Item_T *items;    // Items of the stack
+    int count;              // Number of the items on the stack
+    int capacity;           // Number of the allocated items
+    int top_terminal;       // Index of the terminal closest to the top (-1 ~ none)
+    int last_stop;          // Index of the stop_reduce item closest to the top (-1 ~ none)
 } Stack_T;
 
+// Initial number of the items of the stack
+#define STACK_SIZE 32
+
 /*
  * / ****************** stack_init() ******************* \
  * /Initialization of stack, returns pointer on new stack\
+ * /  (the stack is empty, it is reused by stack_clean())  \
 */
 Stack_T* stack_init();
 
@@ -46,10 +62,17 @@ void stack_pop_item(Stack_T *stack);
 
 /*
  * / ************ stack_clean() ************** \
- * /         Deletes the whole stack           \
+ * /   Deletes all the items of the stack      \
+ * / (the memory is kept for the next expression) \
 */
 void stack_clean(Stack_T *stack);
 
+/*
+ * / ************ stack_dispose() ************** \
+ * /  Frees the whole stack (NULL is accepted)   \
+*/
+void stack_dispose(Stack_T *stack);
+
 /*
  * / *************** stack_pop_item_multi() **************** \
  * /       Can delete more than one item from stack          \
@@ -59,9 +82,17 @@ void stack_pop_item_multi(Stack_T *stack, int how_many);
 /*
  * / **************** stack_first_terminal() ***************** \
  * /Returns pointer on first terminal item in the stack or NULL\
+ * /   (valid until the next push, the stack may be moved)     \
  */
 Stack_Item_T* stack_first_terminal(Stack_T *stack);
 
+/*
+ * / ****************** stack_item() ******************* \
+ * / Returns pointer on the item "depth" items below the top \
+ * /   (0 ~ the top item), or NULL if there is no such item  \
+ */
+Stack_Item_T* stack_item(Stack_T *stack, int depth);
+
 /*                                                                                    |STACK_TOP|
  * / **************** stack_push_item_after_top_terminal() ***************** \        |    E    | ___ Insert here
  * / Inserts an item after a Terminal, located closest to the Top of the stack\       |    $    |
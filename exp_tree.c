@@ -0,0 +1,666 @@
+/* ******************************* exp_tree.c ******************************** */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Expression trees, constant folding and their code           */
+/* *************************************************************************** */
+
+#include "exp_tree.h"   // header file
+#include "code_gen.h"   // print_string_in_ifjcode_form()
+#include <limits.h>     // INT_MIN, INT_MAX
+#include <math.h>       // isfinite()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Creates a new empty tree.
+ *
+ * @returns The new tree, NULL if the allocation failed
+ */
+Exp_Tree_T *exp_tree_init(){
+    Exp_Tree_T *tree = (Exp_Tree_T *) malloc(sizeof(Exp_Tree_T));
+    if (tree == NULL) // Malloc failed
+        return NULL;
+    tree->nodes = NULL;
+    tree->count = 0;
+    tree->capacity = 0;
+    tree->todo = NULL;
+    tree->todo_capacity = 0;
+    tree->operands = NULL;
+    tree->operands_capacity = 0;
+    tree->pools = (Exp_Pool_T *) malloc(sizeof(Exp_Pool_T));
+    if (tree->pools == NULL){ // Malloc failed
+        free(tree);
+        return NULL;
+    }
+    tree->pools[0].func = NULL; // The pool of the main program
+    tree->pools[0].temps = 0;
+    tree->pools_count = 1;
+    tree->pools_capacity = 1;
+    tree->pool = 0;
+    str_pool_init(&tree->strs);
+    return tree;
+}
+
+/**
+ * Deletes all the nodes of the tree, the memory is kept for the next expression.
+ * The folded strings stay valid, they are freed with the tree.
+ *
+ * @param tree Tree to be cleaned
+ */
+void exp_tree_clean(Exp_Tree_T *tree){
+    tree->count = 0;
+}
+
+/**
+ * Frees the whole tree.
+ *
+ * @param tree Tree to be freed (NULL ~ nothing to free)
+ */
+void exp_tree_dispose(Exp_Tree_T *tree){
+    if (tree == NULL)
+        return;
+    free(tree->nodes);
+    free(tree->todo);
+    free(tree->operands);
+    free(tree->pools);
+    str_pool_clean(&tree->strs);
+    free(tree);
+}
+
+/**
+ * Adds a new node to the tree (its fields are not set).
+ *
+ * @param tree Tree to add the node to
+ * @returns The index of the node, -1 if the allocation failed
+ */
+static int new_node(Exp_Tree_T *tree){
+    if (tree->count == tree->capacity){
+        int capacity = (tree->capacity == 0) ? EXP_TREE_SIZE : tree->capacity * 2;
+        Exp_Node_T *nodes = (Exp_Node_T *) realloc(tree->nodes, capacity * sizeof(Exp_Node_T));
+        if (nodes == NULL) // Realloc failed
+            return -1;
+        tree->nodes = nodes;
+        tree->capacity = capacity;
+    }
+    Exp_Node_T *node = &tree->nodes[tree->count];
+    node->left = -1;
+    node->right = -1;
+    node->rule = RULE_UNDEFINED;
+    node->global = false;
+    return tree->count++;
+}
+
+/**
+ * Makes a leaf of a literal or a variable.
+ *
+ * @param tree Tree to add the leaf to
+ * @param token Token of the literal / variable (TOKEN_INT, TOKEN_FLOAT, TOKEN_STR or TOKEN_VAR_ID)
+ * @param type Type of the literal / variable
+ * @param global Indicates if the variable is in the global frame or not
+ * @returns The index of the leaf, -1 if the allocation failed
+ */
+int exp_tree_leaf(Exp_Tree_T *tree, Token_T *token, enum Var_type type, bool global){
+    int index = new_node(tree);
+    if (index == -1) // Allocation failed
+        return -1;
+
+    Exp_Node_T *node = &tree->nodes[index];
+    node->type = type;
+    switch (token->token_type){
+        case TOKEN_INT:
+            node->kind = EXP_INT;
+            node->value.num_integer = token->token_value.num_integer;
+            break;
+        case TOKEN_FLOAT:
+            node->kind = EXP_FLOAT;
+            node->value.num_decimal = token->token_value.num_decimal;
+            break;
+        case TOKEN_STR:
+            node->kind = EXP_STRING;
+            node->value.str = token->token_value.str;
+            break;
+        default: // TOKEN_VAR_ID
+            node->kind = EXP_VAR;
+            node->value.id = token->token_value.str;
+            node->global = global;
+            break;
+    }
+    return index;
+}
+
+/**
+ * Checks if the node is a constant.
+ *
+ * @param node Node of a tree
+ * @returns true if the value of the node is known at compile time
+ */
+static bool is_constant(Exp_Node_T *node){
+    return node->kind == EXP_INT || node->kind == EXP_FLOAT || node->kind == EXP_STRING || node->kind == EXP_BOOL;
+}
+
+/**
+ * Converts an Int constant that is used as a Double (the other operand is a Double).
+ *
+ * @param node Operand to be converted
+ * @param other The other operand
+ */
+static void int_to_double(Exp_Node_T *node, Exp_Node_T *other){
+    if (node->kind == EXP_INT && other->type == DOUBLE){
+        node->kind = EXP_FLOAT;
+        node->type = DOUBLE;
+        node->value.num_decimal = (double) node->value.num_integer;
+    }
+}
+
+/**
+ * Folds a comparison of two constants.
+ *
+ * @param rule Comparison operator
+ * @param cmp Result of the comparison of the constants (<0 ~ less, 0 ~ equal, >0 ~ greater)
+ * @returns The value of the comparison
+ */
+static bool fold_comparison(Prec_rules_T rule, int cmp){
+    switch (rule){
+        case RULE_EQ:         return cmp == 0;
+        case RULE_NOT_EQ:     return cmp != 0;
+        case RULE_LESS:       return cmp < 0;
+        case RULE_GREATER:    return cmp > 0;
+        case RULE_LESS_EQ:    return cmp <= 0;
+        default:              return cmp >= 0; // RULE_GREATER_EQ
+    }
+}
+
+/**
+ * Checks if the operator is a comparison.
+ *
+ * @param rule Operator
+ * @returns true for ==, !=, <, >, <= and >=
+ */
+static bool is_comparison(Prec_rules_T rule){
+    return rule == RULE_EQ || rule == RULE_NOT_EQ || rule == RULE_LESS || rule == RULE_GREATER ||
+           rule == RULE_LESS_EQ || rule == RULE_GREATER_EQ;
+}
+
+/**
+ * Concatenates two string constants (the result has the IFJcode23 form as well).
+ *
+ * @param tree Tree the folded strings are stored in
+ * @param str1 Left string (value of a string literal or a folded string)
+ * @param str2 Right string (value of a string literal or a folded string)
+ * @returns The concatenated string, NULL if the allocation failed
+ */
+static char *concat_strings(Exp_Tree_T *tree, char *str1, char *str2){
+    size_t len1 = strlen(str1), len2 = strlen(str2);
+    size_t ifj_len1, ifj_len2;
+    const char *ifj_str1 = str_lit_ifjcode(str1, &ifj_len1);
+    const char *ifj_str2 = str_lit_ifjcode(str2, &ifj_len2);
+
+    // The string is stored the same way as the string literals are (Str_Lit_T, the value, its IFJcode23 form)
+    char *mem = str_pool_alloc(&tree->strs, sizeof(Str_Lit_T) + len1 + len2 + 1 + ifj_len1 + ifj_len2 + 1);
+    if (mem == NULL) // Allocation failed
+        return NULL;
+    char *str = mem + sizeof(Str_Lit_T);
+    memcpy(str, str1, len1);
+    memcpy(str + len1, str2, len2);
+    str[len1 + len2] = '\0';
+
+    char *ifj_str = str + len1 + len2 + 1;
+    memcpy(ifj_str, ifj_str1, ifj_len1);
+    memcpy(ifj_str + ifj_len1, ifj_str2, ifj_len2);
+    ifj_str[ifj_len1 + ifj_len2] = '\0';
+
+    Str_Lit_T lit;
+    lit.ifj_str = ifj_str;
+    lit.ifj_len = ifj_len1 + ifj_len2;
+    memcpy(mem, &lit, sizeof(Str_Lit_T)); // The strings in the pool are not aligned
+    return str;
+}
+
+/**
+ * Folds an operator with two constant operands into the left operand.
+ * Nothing is folded when the result would differ from the one computed by the interpreter
+ * (overflow, division by zero, division of negative numbers, infinite results).
+ *
+ * @param tree Tree the operands are in
+ * @param rule Operator
+ * @param left Left operand (constant)
+ * @param right Right operand (constant)
+ * @returns 1 if the operator was folded, 0 if it wasn't, -1 if the allocation failed
+ */
+static int fold(Exp_Tree_T *tree, Prec_rules_T rule, Exp_Node_T *left, Exp_Node_T *right){
+    if (left->kind != right->kind)
+        return 0;
+
+    if (left->kind == EXP_INT){
+        long long a = left->value.num_integer, b = right->value.num_integer, result;
+        if (is_comparison(rule)){
+            left->kind = EXP_BOOL;
+            left->type = BOOL;
+            left->value.boolean = fold_comparison(rule, (a > b) - (a < b));
+            return 1;
+        }
+        switch (rule){
+            case RULE_MUL:   result = a * b; break;
+            case RULE_PLUS:  result = a + b; break;
+            case RULE_MINUS: result = a - b; break;
+            case RULE_DIV:
+                if (a < 0 || b <= 0) // Only the division that rounds the same way everywhere
+                    return 0;
+                result = a / b;
+                break;
+            default:
+                return 0;
+        }
+        if (result < INT_MIN || result > INT_MAX) // The constants are ints
+            return 0;
+        left->value.num_integer = (int) result;
+        return 1;
+    }
+
+    if (left->kind == EXP_FLOAT){
+        double a = left->value.num_decimal, b = right->value.num_decimal, result;
+        if (is_comparison(rule)){
+            left->kind = EXP_BOOL;
+            left->type = BOOL;
+            left->value.boolean = fold_comparison(rule, (a > b) - (a < b));
+            return 1;
+        }
+        switch (rule){
+            case RULE_MUL:   result = a * b; break;
+            case RULE_PLUS:  result = a + b; break;
+            case RULE_MINUS: result = a - b; break;
+            case RULE_DIV:
+                if (b == 0.0) // Division by zero is a runtime error
+                    return 0;
+                result = a / b;
+                break;
+            default:
+                return 0;
+        }
+        if (!isfinite(result)) // There is no literal of an infinite number
+            return 0;
+        left->value.num_decimal = result;
+        return 1;
+    }
+
+    if (left->kind == EXP_STRING){
+        if (is_comparison(rule)){
+            left->kind = EXP_BOOL;
+            left->type = BOOL;
+            left->value.boolean = fold_comparison(rule, strcmp(left->value.str, right->value.str));
+            return 1;
+        }
+        if (rule != RULE_PLUS)
+            return 0;
+        char *str = concat_strings(tree, left->value.str, right->value.str);
+        if (str == NULL) // Allocation failed
+            return -1;
+        left->value.str = str;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Makes a node of a binary operator, the operator is folded if both operands are constants.
+ *
+ * @param tree Tree the operands are in
+ * @param rule Operator
+ * @param type Type of the result
+ * @param left Left operand (index of the node)
+ * @param right Right operand (index of the node)
+ * @returns The index of the node (it may be one of the operands), -1 if the allocation failed
+ */
+int exp_tree_binary(Exp_Tree_T *tree, Prec_rules_T rule, enum Var_type type, int left, int right){
+    // Only literals can be on the left of "??" and they are never nil
+    if (rule == RULE_NILL_CMP)
+        return left;
+
+    // Implicit conversion of the Int constants
+    if (rule != RULE_LESS && rule != RULE_GREATER && rule != RULE_LESS_EQ && rule != RULE_GREATER_EQ){
+        int_to_double(&tree->nodes[left], &tree->nodes[right]);
+        int_to_double(&tree->nodes[right], &tree->nodes[left]);
+    }
+
+    if (is_constant(&tree->nodes[left]) && is_constant(&tree->nodes[right])){
+        int folded = fold(tree, rule, &tree->nodes[left], &tree->nodes[right]);
+        if (folded == -1) // Allocation failed
+            return -1;
+        if (folded == 1) // The left operand holds the result now
+            return left;
+    }
+
+    int index = new_node(tree);
+    if (index == -1) // Allocation failed
+        return -1;
+    Exp_Node_T *node = &tree->nodes[index];
+    node->kind = EXP_BINARY;
+    node->type = type;
+    node->rule = rule;
+    node->left = left;
+    node->right = right;
+    return index;
+}
+
+/**
+ * Prints the instruction that pushes the value of a leaf.
+ *
+ * @param node Leaf (not EXP_BINARY)
+ */
+static void emit_leaf(Exp_Node_T *node){
+    switch (node->kind){
+        case EXP_INT:
+            printf("PUSHS int@%d\n", node->value.num_integer);
+            break;
+        case EXP_FLOAT:
+            printf("PUSHS float@%a\n", node->value.num_decimal);
+            break;
+        case EXP_STRING:
+            printf("PUSHS string@");
+            print_string_in_ifjcode_form(node->value.str);
+            printf("\n");
+            break;
+        case EXP_BOOL:
+            printf("PUSHS bool@%s\n", node->value.boolean ? "true" : "false");
+            break;
+        default: // EXP_VAR
+            printf("PUSHS %s@__%s__\n", node->global ? "GF" : "LF", node->value.id);
+            break;
+    }
+}
+
+/**
+ * Prints the instructions of an operator (its operands are on the data stack).
+ *
+ * @param node Node of the operator
+ */
+static void emit_operator(Exp_Node_T *node){
+    switch (node->rule){
+        case RULE_MUL:        printf("MULS\n"); break;
+        case RULE_DIV:        printf((node->type == INT) ? "IDIVS\n" : "DIVS\n"); break;
+        case RULE_PLUS:       printf("ADDS\n"); break;
+        case RULE_MINUS:      printf("SUBS\n"); break;
+        case RULE_EQ:         printf("EQS\n"); break;
+        case RULE_NOT_EQ:     printf("EQS\nNOTS\n"); break;
+        case RULE_LESS:       printf("LTS\n"); break;
+        case RULE_GREATER:    printf("GTS\n"); break;
+        case RULE_LESS_EQ:    printf("GTS\nNOTS\n"); break;
+        case RULE_GREATER_EQ: printf("LTS\nNOTS\n"); break;
+        default:              break;
+    }
+}
+
+/**
+ * Prints the stack code of the tree of the node (the value is left on the data stack).
+ * The tree is walked without recursion, so long expressions can't overflow the C stack.
+ *
+ * @param tree Tree the node is in
+ * @param node Root of the tree to be printed (index of the node)
+ * @returns The correct error return code (0 if success)
+ */
+int exp_tree_emit(Exp_Tree_T *tree, int node){
+    // Every node is on the todo stack twice, before (even) and after (odd) its operands are printed
+    if (tree->todo_capacity < 2 * tree->count){
+        int *todo = (int *) realloc(tree->todo, 2 * tree->count * sizeof(int));
+        if (todo == NULL) // Realloc failed
+            return COMPILER_ERR_INTER;
+        tree->todo = todo;
+        tree->todo_capacity = 2 * tree->count;
+    }
+
+    int count = 0;
+    tree->todo[count++] = 2 * node;
+    while (count != 0){
+        int item = tree->todo[--count];
+        Exp_Node_T *current = &tree->nodes[item / 2];
+        if (current->kind != EXP_BINARY){
+            emit_leaf(current);
+        } else if (item % 2 == 1){ // Both operands are on the data stack
+            emit_operator(current);
+        } else {
+            tree->todo[count++] = item + 1;
+            tree->todo[count++] = 2 * current->right;
+            tree->todo[count++] = 2 * current->left;
+        }
+    }
+    return NO_ERR;
+}
+
+/**
+ * Prints a temporary variable of the current pool (with a space in front of it).
+ *
+ * @param tree Tree with the pools
+ * @param temp Temporary variable
+ */
+static void print_temp(Exp_Tree_T *tree, int temp){
+    char *func = tree->pools[tree->pool].func;
+    if (func == NULL)
+        printf(" GF@$_exp%d_", temp);
+    else
+        printf(" GF@$_%s_exp%d_", func, temp);
+}
+
+/**
+ * Prints an operand of a three-address instruction (with a space in front of it).
+ *
+ * @param tree Tree the operand is in
+ * @param operand Leaf (index of the node) or temporary variable (-1 ~ the first one, -2 ~ the second one, ...)
+ */
+static void print_operand(Exp_Tree_T *tree, int operand){
+    if (operand < 0){
+        print_temp(tree, -operand - 1);
+        return;
+    }
+    Exp_Node_T *node = &tree->nodes[operand];
+    switch (node->kind){
+        case EXP_INT:
+            printf(" int@%d", node->value.num_integer);
+            break;
+        case EXP_FLOAT:
+            printf(" float@%a", node->value.num_decimal);
+            break;
+        case EXP_STRING:
+            printf(" string@");
+            print_string_in_ifjcode_form(node->value.str);
+            break;
+        case EXP_BOOL:
+            printf(" bool@%s", node->value.boolean ? "true" : "false");
+            break;
+        default: // EXP_VAR
+            printf(" %s@__%s__", node->global ? "GF" : "LF", node->value.id);
+            break;
+    }
+}
+
+/**
+ * Prints the destination of a three-address instruction.
+ *
+ * @param tree Tree with the pools
+ * @param dest Variable the value is assigned to (NULL ~ the temporary variable)
+ * @param dest_global Indicates if the variable is in the global frame or not
+ * @param temp Temporary variable (used if dest is NULL)
+ */
+static void print_dest(Exp_Tree_T *tree, char *dest, bool dest_global, int temp){
+    if (dest != NULL)
+        printf(" %s@__%s__", dest_global ? "GF" : "LF", dest);
+    else
+        print_temp(tree, temp);
+}
+
+/**
+ * Prints the three-address instructions of an operator.
+ *
+ * @param tree Tree the operands are in
+ * @param node Node of the operator
+ * @param dest Variable the result is assigned to (NULL ~ the temporary variable)
+ * @param dest_global Indicates if the variable is in the global frame or not
+ * @param temp Temporary variable the result is assigned to (used if dest is NULL)
+ * @param left Left operand (see print_operand())
+ * @param right Right operand (see print_operand())
+ */
+static void emit_operator_tac(Exp_Tree_T *tree, Exp_Node_T *node, char *dest, bool dest_global, int temp, int left, int right){
+    bool negate = false; // !=, <= and >= are the negations of ==, > and <
+    switch (node->rule){
+        case RULE_MUL:        printf("MUL"); break;
+        case RULE_DIV:        printf((node->type == INT) ? "IDIV" : "DIV"); break;
+        case RULE_PLUS:       printf((node->type == STRING) ? "CONCAT" : "ADD"); break;
+        case RULE_MINUS:      printf("SUB"); break;
+        case RULE_EQ:         printf("EQ"); break;
+        case RULE_NOT_EQ:     printf("EQ"); negate = true; break;
+        case RULE_LESS:       printf("LT"); break;
+        case RULE_GREATER:    printf("GT"); break;
+        case RULE_LESS_EQ:    printf("GT"); negate = true; break;
+        default:              printf("LT"); negate = true; break; // RULE_GREATER_EQ
+    }
+    print_dest(tree, dest, dest_global, temp);
+    print_operand(tree, left);
+    print_operand(tree, right);
+    printf("\n");
+    if (negate){
+        printf("NOT");
+        print_dest(tree, dest, dest_global, temp);
+        print_dest(tree, dest, dest_global, temp);
+        printf("\n");
+    }
+}
+
+/**
+ * Prints the three-address code of the tree of the node.
+ * Intermediate results are kept in the temporary variables, they are used like a stack
+ * (the result of an operator takes the place of its first temporary operand),
+ * so an expression needs as many of them as deep its tree is at most.
+ * A leaf or a single operator assigned to a variable is just one instruction.
+ *
+ * @param tree Tree the node is in
+ * @param node Root of the tree to be printed (index of the node)
+ * @param dest Variable the value is assigned to (NULL ~ the value is pushed to the data stack)
+ * @param dest_global Indicates if the variable is in the global frame or not
+ * @returns The correct error return code (0 if success)
+ */
+int exp_tree_emit_tac(Exp_Tree_T *tree, int node, char *dest, bool dest_global){
+    if (tree->nodes[node].kind != EXP_BINARY){ // No operator, the value is just moved / pushed
+        printf((dest != NULL) ? "MOVE" : "PUSHS");
+        if (dest != NULL)
+            print_dest(tree, dest, dest_global, 0);
+        print_operand(tree, node);
+        printf("\n");
+        return NO_ERR;
+    }
+
+    // Every node is on the todo stack twice, before (even) and after (odd) its operands are printed
+    if (tree->todo_capacity < 2 * tree->count){
+        int *todo = (int *) realloc(tree->todo, 2 * tree->count * sizeof(int));
+        if (todo == NULL) // Realloc failed
+            return COMPILER_ERR_INTER;
+        tree->todo = todo;
+        tree->todo_capacity = 2 * tree->count;
+    }
+    if (tree->operands_capacity < tree->count){
+        int *operands = (int *) realloc(tree->operands, tree->count * sizeof(int));
+        if (operands == NULL) // Realloc failed
+            return COMPILER_ERR_INTER;
+        tree->operands = operands;
+        tree->operands_capacity = tree->count;
+    }
+
+    int count = 0, operands = 0, temps = 0; // temps ~ number of the temporary variables in use
+    tree->todo[count++] = 2 * node;
+    while (count != 0){
+        int item = tree->todo[--count];
+        Exp_Node_T *current = &tree->nodes[item / 2];
+        if (current->kind != EXP_BINARY){
+            tree->operands[operands++] = item / 2;
+        } else if (item % 2 == 1){ // Both operands are printed
+            int right = tree->operands[--operands];
+            int left = tree->operands[--operands];
+            int temp;
+            if (left < 0){ // The right one is either a leaf or the next temporary variable
+                temp = -left - 1;
+                temps = temp + 1;
+            } else if (right < 0){
+                temp = -right - 1;
+            } else {
+                temp = temps++;
+            }
+            if (temps > tree->pools[tree->pool].temps)
+                tree->pools[tree->pool].temps = temps;
+
+            if (item / 2 == node && dest != NULL){ // The root is assigned right away
+                emit_operator_tac(tree, current, dest, dest_global, temp, left, right);
+                return NO_ERR;
+            }
+            emit_operator_tac(tree, current, NULL, false, temp, left, right);
+            tree->operands[operands++] = -temp - 1;
+        } else {
+            tree->todo[count++] = item + 1;
+            tree->todo[count++] = 2 * current->right;
+            tree->todo[count++] = 2 * current->left;
+        }
+    }
+    printf("PUSHS"); // The value of the root is in a temporary variable
+    print_temp(tree, -tree->operands[0] - 1);
+    printf("\n");
+    return NO_ERR;
+}
+
+/**
+ * Starts using the pool of the temporary variables of a function.
+ * Every function gets a pool of its own, the pool of the main program is kept
+ * for all its parts (the main program continues after a function definition).
+ *
+ * @param tree Tree with the pools
+ * @param func Id of the function (NULL ~ the main program)
+ * @returns The correct error return code (0 if success)
+ */
+int exp_tree_pool(Exp_Tree_T *tree, char *func){
+    if (func == NULL){
+        tree->pool = 0;
+        return NO_ERR;
+    }
+    if (tree->pools_count == tree->pools_capacity){
+        Exp_Pool_T *pools = (Exp_Pool_T *) realloc(tree->pools, 2 * tree->pools_capacity * sizeof(Exp_Pool_T));
+        if (pools == NULL) // Realloc failed
+            return COMPILER_ERR_INTER;
+        tree->pools = pools;
+        tree->pools_capacity *= 2;
+    }
+    tree->pool = tree->pools_count++;
+    tree->pools[tree->pool].func = func;
+    tree->pools[tree->pool].temps = 0;
+    return NO_ERR;
+}
+
+/**
+ * Prints the code before the program, it jumps to the definitions
+ * of the temporary variables (they are printed after the program).
+ */
+void exp_tree_prologue(){
+#ifndef EXP_STACK_CODE
+    printf("JUMP $%%exp_temps\nLABEL $%%exp_main\n");
+#endif
+}
+
+/**
+ * Prints the code after the program, it defines the temporary variables
+ * of all the pools and goes back to the start of the program.
+ *
+ * @param tree Tree of the expressions (NULL ~ no expression was parsed)
+ */
+void exp_tree_epilogue(Exp_Tree_T *tree){
+#ifndef EXP_STACK_CODE
+    printf("JUMP $%%exp_end\nLABEL $%%exp_temps\n");
+    for (int p = 0; tree != NULL && p < tree->pools_count; p++){
+        tree->pool = p;
+        for (int i = 0; i < tree->pools[p].temps; i++){
+            printf("DEFVAR");
+            print_temp(tree, i);
+            printf("\n");
+        }
+    }
+    printf("JUMP $%%exp_main\nLABEL $%%exp_end\n");
+#else
+    (void) tree;
+#endif
+}
+/* End of exp_tree.c */
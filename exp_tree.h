@@ -0,0 +1,157 @@
+/* ******************************* exp_tree.h ******************************** */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Header file for exp_tree.c                                  */
+/* *************************************************************************** */
+
+#ifndef EXP_TREE_H
+#define EXP_TREE_H
+
+#include "exp_parser.h"
+#include "str_pool.h"
+#include <stdbool.h>
+
+/*
+ * / ******************** Exp_Node_Kind_T ********************* \
+ * / Enumeration that holds all the kinds of the expression nodes \
+*/
+typedef enum Exp_Node_Kind {
+    EXP_INT,      // Int constant
+    EXP_FLOAT,    // Double constant
+    EXP_STRING,   // String constant
+    EXP_BOOL,     // Bool constant (folded comparison)
+    EXP_VAR,      // Variable
+    EXP_BINARY    // Binary operator
+} Exp_Node_Kind_T;
+
+/*
+ * / ******************* Exp_Node_T ******************** \
+ * / Structure that holds one node of an expression tree \
+*/
+typedef struct Exp_Node {
+    Exp_Node_Kind_T kind;     // Kind of the node
+    enum Var_type type;       // Type of the value of the node
+    Prec_rules_T rule;        // Operator (EXP_BINARY only)
+    int left;                 // Left operand (index of the node, EXP_BINARY only)
+    int right;                // Right operand (index of the node, EXP_BINARY only)
+    union {
+        int num_integer;      // Value of EXP_INT
+        double num_decimal;   // Value of EXP_FLOAT
+        char *str;            // Value of EXP_STRING (it has the IFJcode23 form, see str_lit_ifjcode())
+        bool boolean;         // Value of EXP_BOOL
+        char *id;             // Id of EXP_VAR
+    } value;
+    bool global;              // Indicates if the variable is in the global frame or not (EXP_VAR only)
+} Exp_Node_T;
+
+/*
+ * / ******************** Exp_Pool_T ********************* \
+ * / Structure that holds the temporary variables of a function \
+*/
+typedef struct Exp_Pool {
+    char *func;           // Id of the function (NULL ~ the main program)
+    int temps;            // Number of the temporary variables used by the expressions of the function
+} Exp_Pool_T;
+
+/*
+ * / ************************** Exp_Tree_T *************************** \
+ * / Structure that holds the nodes of the expression being parsed      \
+ * / The nodes are stored in one array (they link each other by indices) \
+ * / that belongs to the parser and is reused by all the expressions     \
+*/
+typedef struct Exp_Tree {
+    Exp_Node_T *nodes;    // Nodes of the tree
+    int count;            // Number of the nodes
+    int capacity;         // Number of the allocated nodes
+    int *todo;            // Stack of the nodes waiting to be printed (see exp_tree_emit())
+    int todo_capacity;    // Number of the allocated items of the todo stack
+    int *operands;        // Stack of the printed operands (three-address code, see exp_tree_emit_tac())
+    int operands_capacity;// Number of the allocated items of the operands stack
+    Exp_Pool_T *pools;    // Pools of the temporary variables (the first one belongs to the main program)
+    int pools_count;      // Number of the pools
+    int pools_capacity;   // Number of the allocated pools
+    int pool;             // Pool of the function being parsed (index)
+    Str_Pool_T strs;      // Strings made by folding (valid until the tree is disposed)
+} Exp_Tree_T;
+
+/* Initial number of the nodes of the tree */
+#define EXP_TREE_SIZE 32
+
+/*
+ * / ***************** exp_tree_init() ****************** \
+ * / Function that creates a new empty tree (NULL ~ error) \
+*/
+Exp_Tree_T *exp_tree_init();
+
+/*
+ * / ****************** exp_tree_clean() ******************* \
+ * / Function that deletes all the nodes (the memory is kept) \
+*/
+void exp_tree_clean(Exp_Tree_T *tree);
+
+/*
+ * / ************** exp_tree_dispose() *************** \
+ * / Function that frees the whole tree (NULL is accepted) \
+*/
+void exp_tree_dispose(Exp_Tree_T *tree);
+
+/*
+ * / ********************** exp_tree_leaf() ********************** \
+ * / Function that makes a leaf of a literal / variable token        \
+ * / Returns the index of the node, -1 if the allocation failed      \
+*/
+int exp_tree_leaf(Exp_Tree_T *tree, Token_T *token, enum Var_type type, bool global);
+
+/*
+ * / ************************ exp_tree_binary() ************************* \
+ * / Function that makes a node of a binary operator, constant operands     \
+ * / are folded into a constant node right away                             \
+ * / Returns the index of the node, -1 if the allocation failed             \
+*/
+int exp_tree_binary(Exp_Tree_T *tree, Prec_rules_T rule, enum Var_type type, int left, int right);
+
+/*
+ * / ******************** exp_tree_emit() ********************* \
+ * / Function that prints the stack code of the tree of the node \
+*/
+int exp_tree_emit(Exp_Tree_T *tree, int node);
+
+/*
+ * Expressions are lowered to the stack code by default (~ -DEXP_STACK_CODE),
+ * make LOWERING=tac lowers them to three-address code (ADD GF@$_f_exp0_ LF@__a__ int@1, ...)
+ * Every function has its own pool of the temporary variables (GF@$_f_expN_, GF@$_expN_ in the main program),
+ * they are in the global frame as the bodies of if / while push frames of their own,
+ * no value of them lives across a call (the variables are defined once, see exp_tree_epilogue())
+ */
+
+/*
+ * / ********************** exp_tree_pool() *********************** \
+ * / Function that starts using the temporary variables of a function \
+ * / (func NULL ~ back to the main program)                          \
+*/
+int exp_tree_pool(Exp_Tree_T *tree, char *func);
+
+/*
+ * / *********************** exp_tree_emit_tac() ************************ \
+ * / Function that prints the three-address code of the tree of the node    \
+ * / The value is assigned to the variable dest (dest_global ~ its frame),   \
+ * / or it is pushed to the data stack if dest is NULL                       \
+*/
+int exp_tree_emit_tac(Exp_Tree_T *tree, int node, char *dest, bool dest_global);
+
+/*
+ * / ******************* exp_tree_prologue() ******************** \
+ * / Function that prints the code before the program (three-address \
+ * / code only, it jumps to the definitions of the temporaries)       \
+*/
+void exp_tree_prologue();
+
+/*
+ * / ******************* exp_tree_epilogue() ******************** \
+ * / Function that prints the code after the program (three-address  \
+ * / code only, it defines the temporaries used by tree, NULL ~ none) \
+*/
+void exp_tree_epilogue(Exp_Tree_T *tree);
+
+#endif
+/* End of exp_tree.h */
@@ -10,12 +10,21 @@
 #include <string.h>
 #include "scanner.h"
 #include "parser.h"
+#include "token_stream.h"
 #include "dynamic_str.h"
 #include "utils.h"
 
 int main(int argc, char *argv[]){
     // Set up the file
     set_file(stdin);
+    // Scan the whole source at once (big sources are split between the processors)
+    Token_Stream_T tokens;
+    if (token_stream_build_parallel(&tokens, 0) != NO_ERR){
+        token_stream_free(&tokens);
+        return get_err_type(COMPILER_ERR_INTER);
+    }
     // Run the parser
-    return get_err_type(parse());
+    int result = parse_token_stream(&tokens);
+    token_stream_free(&tokens);
+    return get_err_type(result);
 }
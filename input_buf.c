@@ -0,0 +1,268 @@
+/* ******************************* input_buf.c ******************************* */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Load the source code into the memory for the scanner        */
+/* *************************************************************************** */
+
+#define _POSIX_C_SOURCE 200809L   // fileno(), mmap(), ...
+
+#include "input_buf.h"   // header file
+#include <stdlib.h>      // malloc(), realloc(), free()
+#include <string.h>      // memcpy(), memmove()
+#include <sys/mman.h>    // mmap(), munmap()
+#include <sys/stat.h>    // fstat()
+#include <unistd.h>      // lseek(), read()
+#include <errno.h>       // errno, EINTR
+
+/**
+ * Tries to memory-map the whole stream (works only for regular files).
+ *
+ * @param buf Input buffer to be set up
+ * @param f Source stream
+ * @returns true if the stream was mapped, false otherwise
+ */
+static bool input_buf_map(Input_Buf_T *buf, FILE *f){
+    int fd = fileno(f);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+        return false; // Pipes, terminals and empty files are read into a buffer
+
+    off_t offset = lseek(fd, 0, SEEK_CUR); // Part of the file might have been read already
+    if (offset < 0 || offset > st.st_size)
+        return false;
+
+    void *data = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        return false;
+    posix_madvise(data, (size_t) st.st_size, POSIX_MADV_SEQUENTIAL); // The scanner reads the file from start to end
+
+    buf->data = (unsigned char *) data;
+    buf->len = (size_t) st.st_size;
+    buf->pos = (size_t) offset;
+    buf->mapped = true;
+    buf->file = NULL; // Everything is loaded already
+    return true;
+}
+
+/**
+ * Sets up the input buffer for the given stream.
+ *
+ * @param buf Input buffer to be set up
+ * @param f Source stream
+ * @returns 0 ~ INPUT_BUF_OK   — No errors have occured
+ *          1 ~ INPUT_BUF_ERR  — An error has occured
+ */
+int input_buf_open(Input_Buf_T *buf, FILE *f){
+    buf->data = NULL;
+    buf->len = 0;
+    buf->pos = 0;
+    buf->capacity = 0;
+    buf->file = f;
+    buf->mapped = false;
+    buf->failed = false;
+    buf->awaiting = false;
+
+    if (f == NULL)
+        return INPUT_BUF_ERR;
+
+    if (input_buf_map(buf, f))
+        return INPUT_BUF_OK;
+
+    // Stream can't be mapped, the chunks are loaded on demand
+    buf->data = (unsigned char *) malloc(INPUT_BUF_CHUNK);
+    if (buf->data == NULL){ // Malloc failed
+        buf->failed = true;
+        buf->file = NULL;
+        return INPUT_BUF_ERR;
+    }
+    buf->capacity = INPUT_BUF_CHUNK;
+    return INPUT_BUF_OK;
+}
+
+/**
+ * Sets up an empty input buffer the input is pushed to by input_buf_push().
+ *
+ * @param buf Input buffer to be set up
+ */
+void input_buf_open_push(Input_Buf_T *buf){
+    buf->data = NULL;
+    buf->len = 0;
+    buf->pos = 0;
+    buf->capacity = 0;
+    buf->file = NULL; // Nothing is read from a stream
+    buf->mapped = false;
+    buf->failed = false;
+    buf->awaiting = true;
+}
+
+/**
+ * Appends n bytes of the input to the buffer.
+ *
+ * @param buf Input buffer set up by input_buf_open_push()
+ * @param data Bytes to be appended
+ * @param n Number of the bytes
+ * @returns 0 ~ INPUT_BUF_OK   — No errors have occured
+ *          1 ~ INPUT_BUF_ERR  — An error has occured
+ */
+int input_buf_push(Input_Buf_T *buf, const char *data, size_t n){
+    if (!buf->awaiting || buf->mapped)
+        return INPUT_BUF_ERR;
+
+    // Allocate more memory if needed
+    if (buf->capacity - buf->len < n){
+        size_t new_capacity = (buf->capacity == 0) ? INPUT_BUF_CHUNK : buf->capacity;
+        while (new_capacity - buf->len < n) // Grow geometrically to keep the pushes amortized
+            new_capacity *= 2;
+        unsigned char *new_data = (unsigned char *) realloc(buf->data, new_capacity);
+        if (new_data == NULL){ // Realloc failed
+            buf->failed = true;
+            return INPUT_BUF_ERR;
+        }
+        buf->data = new_data;
+        buf->capacity = new_capacity;
+    }
+
+    if (n > 0)
+        memcpy(buf->data + buf->len, data, n);
+    buf->len += n;
+    return INPUT_BUF_OK;
+}
+
+/**
+ * Loads the next chunk of the input from the stream.
+ *
+ * @param buf Input buffer to be refilled
+ * @returns 0 ~ INPUT_BUF_OK   — No errors have occured
+ *          1 ~ INPUT_BUF_ERR  — An error has occured
+ */
+int input_buf_refill(Input_Buf_T *buf){
+    if (buf->file == NULL) // Everything is loaded already
+        return INPUT_BUF_OK;
+
+    // Allocate more memory if needed
+    if (buf->capacity - buf->len < INPUT_BUF_CHUNK){
+        size_t new_capacity = buf->capacity * 2; // Grow geometrically to keep the refills amortized
+        unsigned char *new_data = (unsigned char *) realloc(buf->data, new_capacity);
+        if (new_data == NULL){ // Realloc failed
+            buf->failed = true;
+            buf->file = NULL;
+            return INPUT_BUF_ERR;
+        }
+        buf->data = new_data;
+        buf->capacity = new_capacity;
+    }
+
+    // Read whatever is available right now (read() doesn't wait for the whole chunk like fread() does)
+    ssize_t loaded;
+    do {
+        loaded = read(fileno(buf->file), buf->data + buf->len, buf->capacity - buf->len);
+    } while (loaded < 0 && errno == EINTR);
+
+    if (loaded <= 0){ // The end of the stream (or a read error)
+        buf->failed = loaded < 0;
+        buf->file = NULL;
+        return loaded < 0 ? INPUT_BUF_ERR : INPUT_BUF_OK;
+    }
+    buf->len += (size_t) loaded;
+
+    return INPUT_BUF_OK;
+}
+
+/**
+ * Loads the rest of the stream into the buffer.
+ *
+ * @param buf Input buffer to be loaded
+ * @returns 0 ~ INPUT_BUF_OK   — No errors have occured
+ *          1 ~ INPUT_BUF_ERR  — An error has occured
+ */
+int input_buf_load_all(Input_Buf_T *buf){
+    while (buf->file != NULL){ // Until the end of the stream
+        if (input_buf_refill(buf) != INPUT_BUF_OK)
+            return INPUT_BUF_ERR;
+    }
+    return buf->failed ? INPUT_BUF_ERR : INPUT_BUF_OK;
+}
+
+/**
+ * Sets up a read-only view of an already loaded buffer with its own cursor.
+ *
+ * @param view View to be set up
+ * @param buf Loaded input buffer
+ * @param pos Position of the cursor of the view
+ */
+void input_buf_view(Input_Buf_T *view, const Input_Buf_T *buf, size_t pos){
+    view->data = buf->data;
+    view->len = buf->len;
+    view->pos = pos;
+    view->capacity = 0;
+    view->file = NULL; // Nothing more will be loaded
+    view->mapped = buf->mapped;
+    view->failed = buf->failed;
+    view->awaiting = false;
+}
+
+/**
+ * Replaces a range of the loaded source with a text (the whole stream is loaded first).
+ * Memory-mapped source is copied into a buffer as the file itself must not change.
+ *
+ * @param buf Input buffer to be edited
+ * @param offset Offset of the replaced range
+ * @param removed Number of the replaced bytes
+ * @param inserted Text to be inserted
+ * @param inserted_len Length of the inserted text
+ * @returns 0 ~ INPUT_BUF_OK   — No errors have occured
+ *          1 ~ INPUT_BUF_ERR  — An error has occured
+ */
+int input_buf_edit(Input_Buf_T *buf, size_t offset, size_t removed, const char *inserted, size_t inserted_len){
+    if (input_buf_load_all(buf) != INPUT_BUF_OK || offset > buf->len || removed > buf->len - offset)
+        return INPUT_BUF_ERR;
+
+    size_t tail = buf->len - offset - removed; // Bytes after the replaced range
+    size_t new_len = buf->len - removed + inserted_len;
+    if (buf->mapped || new_len > buf->capacity){ // Move the source into a bigger buffer
+        size_t new_capacity = (buf->capacity > INPUT_BUF_CHUNK) ? buf->capacity : INPUT_BUF_CHUNK;
+        while (new_capacity < new_len)
+            new_capacity *= 2;
+        unsigned char *new_data = (unsigned char *) malloc(new_capacity);
+        if (new_data == NULL) // Malloc failed
+            return INPUT_BUF_ERR;
+        memcpy(new_data, buf->data, offset);
+        memcpy(new_data + offset + inserted_len, buf->data + offset + removed, tail);
+        if (buf->mapped)
+            munmap(buf->data, buf->len);
+        else
+            free(buf->data);
+        buf->data = new_data;
+        buf->capacity = new_capacity;
+        buf->mapped = false;
+    } else {
+        memmove(buf->data + offset + inserted_len, buf->data + offset + removed, tail);
+    }
+    if (inserted_len > 0)
+        memcpy(buf->data + offset, inserted, inserted_len);
+    buf->len = new_len;
+    if (buf->pos > offset) // The cursor can't point into the replaced range
+        buf->pos = offset;
+    return INPUT_BUF_OK;
+}
+
+/**
+ * Releases all the resources held by the input buffer.
+ *
+ * @param buf Input buffer to be closed
+ */
+void input_buf_close(Input_Buf_T *buf){
+    if (buf->mapped){
+        munmap(buf->data, buf->len);
+    } else {
+        free(buf->data);
+    }
+    buf->data = NULL;
+    buf->len = 0;
+    buf->pos = 0;
+    buf->capacity = 0;
+    buf->file = NULL;
+    buf->mapped = false;
+    buf->awaiting = false;
+}
+/* End of input_buf.c */
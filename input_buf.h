@@ -0,0 +1,120 @@
+/* ******************************* input_buf.h ******************************* */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Header file for input_buf.c                                 */
+/* *************************************************************************** */
+
+#ifndef INPUT_BUF_H
+#define INPUT_BUF_H
+
+#include <stdio.h>    // FILE, EOF
+#include <stddef.h>   // size_t
+#include <stdbool.h>
+
+/* Number of bytes read from a stream at once */
+#define INPUT_BUF_CHUNK 65536
+
+/* Return values */
+#define INPUT_BUF_OK 0    // No errors have occured
+#define INPUT_BUF_ERR 1   // An error has occured
+
+/*
+ * / ************************** Input_Buf_T *************************** \
+ * / Structure that holds the source code loaded into the memory         \
+ * / Regular files are memory-mapped, pipes and terminals are read into  \
+ * / a buffer that grows as more input arrives (already loaded bytes are \
+ * / never discarded, so the offsets into the buffer stay valid)         \
+ * / The input can also be pushed to the buffer by the caller            \
+*/
+typedef struct Input_Buf {
+    unsigned char *data;   // Loaded source code
+    size_t len;            // Number of loaded bytes
+    size_t pos;            // Cursor (offset of the next byte to read)
+    size_t capacity;       // Number of allocated bytes (0 for the mapped input)
+    FILE *file;            // Stream to read from (NULL once everything is loaded)
+    bool mapped;           // Indicates if the data are memory-mapped or not
+    bool failed;           // Indicates if loading the input has failed or not
+    bool awaiting;         // Indicates if more input can still be pushed to the buffer
+} Input_Buf_T;
+
+/*
+ * / ******************** input_buf_open() ********************* \
+ * / Function that sets up the input buffer for the given stream \
+*/
+int input_buf_open(Input_Buf_T *buf, FILE *f);
+
+/*
+ * / ****************** input_buf_open_push() ******************* \
+ * / Function that sets up an empty input buffer the input is pushed to \
+*/
+void input_buf_open_push(Input_Buf_T *buf);
+
+/*
+ * / ******************* input_buf_push() ******************** \
+ * / Function that appends n bytes of the input to the buffer \
+*/
+int input_buf_push(Input_Buf_T *buf, const char *data, size_t n);
+
+/*
+ * / ****************** input_buf_refill() ******************* \
+ * / Function that loads the next chunk of input from the stream \
+*/
+int input_buf_refill(Input_Buf_T *buf);
+
+/*
+ * / ***************** input_buf_load_all() ****************** \
+ * / Function that loads the rest of the stream into the buffer \
+*/
+int input_buf_load_all(Input_Buf_T *buf);
+
+/*
+ * / ******************** input_buf_view() ********************* \
+ * / Function that sets up a read-only view of an already loaded \
+ * / buffer with its own cursor (the view must not be closed)    \
+*/
+void input_buf_view(Input_Buf_T *view, const Input_Buf_T *buf, size_t pos);
+
+/*
+ * / ********************* input_buf_edit() ********************** \
+ * / Function that replaces a range of the loaded source with a text \
+*/
+int input_buf_edit(Input_Buf_T *buf, size_t offset, size_t removed, const char *inserted, size_t inserted_len);
+
+/*
+ * / ************************* input_buf_close() ************************** \
+ * / Function that releases all the resources held by the input buffer \
+*/
+void input_buf_close(Input_Buf_T *buf);
+
+/*
+ * / *********************** input_peek() ************************ \
+ * / Function that returns the next character without consuming it \
+*/
+static inline int input_peek(Input_Buf_T *buf){
+    if (buf->pos == buf->len && (buf->file == NULL || input_buf_refill(buf) != INPUT_BUF_OK || buf->pos == buf->len))
+        return EOF; // The whole input was read
+    return buf->data[buf->pos];
+}
+
+/*
+ * / ****************** input_getc() ******************* \
+ * / Function that returns and consumes the next character \
+*/
+static inline int input_getc(Input_Buf_T *buf){
+    int c = input_peek(buf);
+    if (c != EOF)
+        buf->pos++;
+    return c;
+}
+
+/*
+ * / ********************* input_unget() ********************** \
+ * / Function that moves the cursor back by the consumed character \
+*/
+static inline void input_unget(Input_Buf_T *buf, int c){
+    if (c != EOF) // EOF doesn't consume anything
+        buf->pos--;
+}
+
+#endif
+/* End of input_buf.h */
@@ -0,0 +1,27 @@
+/* ******************************** num_conv.h ******************************* */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Header file for num_conv.c                                  */
+/* *************************************************************************** */
+
+#ifndef NUM_CONV_H
+#define NUM_CONV_H
+
+#include <stddef.h>   // size_t
+
+/*
+ * / ********************** num_to_uint() ********************** \
+ * / Function that converts the digits of an integer literal      \
+ * / (saturates at ULONG_MAX just like strtoul() does)            \
+*/
+unsigned long num_to_uint(const char *str, size_t len);
+
+/*
+ * / ********************* num_to_double() ********************* \
+ * / Function that converts a float literal (digits, '.', 'e') to \
+ * / the nearest double (correctly rounded, just like strtod())   \
+*/
+double num_to_double(const char *str, size_t len);
+
+#endif
+/* End of num_conv.h */
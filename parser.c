@@ -7,6 +7,8 @@
 
 #include "parser.h"   // header file
 #include "exp_parser.h"
+#include "exp_stack.h"
+#include "exp_tree.h"
 #include "code_gen.h"
 #include "dynamic_str.h"
 #include <stdlib.h>
@@ -50,21 +52,53 @@ enum Var_type predef_functions_ret_type[PREDEF_FUNCTIONS_CNT] = {
 Parser_T parser;
 
 /**
- * Gets a new token from the scanner and skips all the EOL tokens if needed. 
+ * Gets the next token that isn't EOL from the token stream.
  *
- * @param t Token to load from the scanner
+ * @param t Token to load
  * @returns The correct error return code (0 if success)
  */
 int skip_EOL(Token_T *t){
-    int result; // Variable that holds the return value
-    if (parser.EOL_skip == true){ // Skipping the EOL tokens
-        do {
-            TOKENCHECKHELP(t)
-        } while (t->token_type == TOKEN_EOL);
-    } else { // Not skipping the EOL tokens
-        TOKENCHECKHELP(t)
+    token_stream_skip(parser.tokens, TOKEN_EOL);
+    return token_stream_advance(parser.tokens, t);
+}
+
+/**
+ * Gets the next token from the token stream, EOL tokens included (they end the expressions).
+ *
+ * @param t Token to load
+ * @returns The correct error return code (0 if success)
+ */
+int next_token(Token_T *t){
+    return token_stream_advance(parser.tokens, t);
+}
+
+/**
+ * Looks at the type of the next token that isn't EOL without loading it.
+ *
+ * @param type Type of the token
+ * @returns The correct error return code (0 if success)
+ */
+int peek_token(Token_Type_T *type){
+    token_stream_skip(parser.tokens, TOKEN_EOL);
+    return token_stream_peek(parser.tokens, 0, type);
+}
+
+/**
+ * Resolves the variable ID of a token to its symbol in the current scopes.
+ * The symbol is saved in the token, so every later use of the same token (and its copies)
+ * reads it without searching the symtables again.
+ *
+ * @param parser Parser with the symtable stack of the current scopes
+ * @param token Token with the variable ID
+ * @returns A pointer to the symbol or NULL if the variable is not defined
+ */
+TNode *resolve_symbol(Parser_T *parser, Token_T *token){
+    if (token->symbol == NULL){ // Not resolved yet
+        TTree *symtable = NULL;
+        token->symbol = search_st_stack_scope(parser->var_st_stack, token->token_value.str, &symtable);
+        token->global_symbol = symtable == parser->global_var_symbtable;
     }
-    return 0;
+    return token->symbol;
 }
 
 /**
@@ -84,21 +118,20 @@ int handle_write(){
                 break;
             case TOKEN_STR:
                 printf("WRITE string@");
-                print_string_in_ifjcode_form(parser.current_token.token_value.dyn_str.dynamic_str); // Print the string
+                print_string_in_ifjcode_form(parser.current_token.token_value.str); // Print the string
                 printf("\n");
                 break;
             case TOKEN_VAR_ID: ;            
-                TNode *found_var = search_st_stack(parser.var_st_stack, parser.current_token.token_value.dyn_str.dynamic_str);
+                TNode *found_var = resolve_symbol(&parser, &parser.current_token);
                 if (found_var == NULL) // The passed variable is NOT defined
                     return SEMANTIC_ERR_C; 
 
-                if (found_var->variable_data.init == false && found_var->variable_data.is_param == false){
+                if (found_var->data.variable_data.init == false && found_var->data.variable_data.is_param == false){
                     return SEMANTIC_ERR_C; // The passed variable is NOT initialized
                 }
 
-                TNode *found_var_global = search_symbol(parser.global_var_symbtable->root, parser.current_token.token_value.dyn_str.dynamic_str);
-                if (found_var == found_var_global){ // The passed variable is a global variable
-                    printf("WRITE GF@__%s__\n", found_var_global->id); // Print the global variable
+                if (parser.current_token.global_symbol){ // The passed variable is a global variable
+                    printf("WRITE GF@__%s__\n", found_var->id); // Print the global variable
                 } else { // The passed variable is a local variable
                     printf("WRITE LF@__%s__\n", found_var->id); // Print the local variable
                 }
@@ -129,32 +162,34 @@ int handle_write(){
  * @returns The correct error return code, 0 if success
  */
 int check_term(Arguments_Data_T *input_params_data, TNode *searched_node, int *loaded_paramas_cnt){
+    input_params_data[*loaded_paramas_cnt].param_id = NULL; // Only a variable argument has an id (the array isn't initialized)
     switch(input_params_data[*loaded_paramas_cnt].term.token_type){
         case TOKEN_INT:
-            if (searched_node->function_data.parameters[*loaded_paramas_cnt].type != INT && searched_node->function_data.parameters[*loaded_paramas_cnt].type != INT_KW)
+            if (searched_node->data.function_data.parameters[*loaded_paramas_cnt].type != INT && searched_node->data.function_data.parameters[*loaded_paramas_cnt].type != INT_KW)
                 return SEMANTIC_ERR_B; // The function argument type doen't match the function parameter type
             break;
         case TOKEN_FLOAT:
-            if (searched_node->function_data.parameters[*loaded_paramas_cnt].type != DOUBLE && searched_node->function_data.parameters[*loaded_paramas_cnt].type != DOUBLE_KW)
+            if (searched_node->data.function_data.parameters[*loaded_paramas_cnt].type != DOUBLE && searched_node->data.function_data.parameters[*loaded_paramas_cnt].type != DOUBLE_KW)
                 return SEMANTIC_ERR_B; // The function argument type doen't match the function parameter type
             break;
         case TOKEN_STR:
 
-            if (searched_node->function_data.parameters[*loaded_paramas_cnt].type != STRING && searched_node->function_data.parameters[*loaded_paramas_cnt].type != STRING_NIL)
+            if (searched_node->data.function_data.parameters[*loaded_paramas_cnt].type != STRING && searched_node->data.function_data.parameters[*loaded_paramas_cnt].type != STRING_NIL)
                 return SEMANTIC_ERR_B; // The function argument type doen't match the function parameter type
             break;
         case TOKEN_VAR_ID: ;
-            TNode *found_var = search_st_stack(parser.var_st_stack, input_params_data[*loaded_paramas_cnt].term.token_value.dyn_str.dynamic_str);
+            TNode *found_var = resolve_symbol(&parser, &input_params_data[*loaded_paramas_cnt].term);
             if (found_var == NULL) // The passed variable is NOT defined
                 return SEMANTIC_ERR_B;
-            if (found_var->variable_data.init == false) // The passed variable is NOT initialized
+            if (found_var->data.variable_data.init == false) // The passed variable is NOT initialized
                 return SEMANTIC_ERR_C;
 
-            if (found_var->variable_data.type != searched_node->function_data.parameters[*loaded_paramas_cnt].type)
+            if (found_var->data.variable_data.type != searched_node->data.function_data.parameters[*loaded_paramas_cnt].type)
                 return SEMANTIC_ERR_B; // The function argument type doen't match the function parameter type
+            input_params_data[*loaded_paramas_cnt].param_id = input_params_data[*loaded_paramas_cnt].term.token_value.str;
             break;
         case TOKEN_KEYWORD:
-            if (parser.current_token.token_value.token_keyword == NIL_KW && (searched_node->function_data.parameters[*loaded_paramas_cnt].type == INT_NIL || searched_node->function_data.parameters[*loaded_paramas_cnt].type != DOUBLE_NIL || searched_node->function_data.parameters[*loaded_paramas_cnt].type == STRING_NIL))
+            if (parser.current_token.token_value.token_keyword == NIL_KW && (searched_node->data.function_data.parameters[*loaded_paramas_cnt].type == INT_NIL || searched_node->data.function_data.parameters[*loaded_paramas_cnt].type != DOUBLE_NIL || searched_node->data.function_data.parameters[*loaded_paramas_cnt].type == STRING_NIL))
                 return NO_ERR; // The special nil characted
             else
                 return SEMANTIC_ERR_B; // The function argument type doen't match the function parameter type
@@ -187,6 +222,7 @@ int create_global_symtables(Parser_T *parser){
     parser->var_st_stack = (Symtable_Stack_T *) malloc(sizeof(Symtable_Stack_T));
     if (parser->var_st_stack == NULL)
         return COMPILER_ERR_INTER; // Malloc failed
+    st_stack_init(parser->var_st_stack);
 
     // Push the empty global variable symtable to the variable symtable stack
     RETURNCHECK(st_stack_push(parser->var_st_stack, parser->global_var_symbtable))
@@ -197,20 +233,23 @@ int create_global_symtables(Parser_T *parser){
 
 /**
  * @brief Creates a new empty local symtable and pushes it to the variable symtable stack.
+ * The symtable itself is only allocated when the first variable of the block is defined.
  *
- * @param local_symtable Local symtable to be created and pushed to the varialbe symtable stack
  * @param parser Parser that holds the variable symtable stack to push the local symtable into
  * @returns The correct error return code (0 if success)
  */
-int create_local_symtable(Parser_T *parser, TTree *local_symtable){
-    // Allocate memory for the new local symtable
-    local_symtable = (TTree *) malloc(sizeof(TTree));
-    if (local_symtable == NULL) // Malloc failed
-        return COMPILER_ERR_INTER;
-    
-    // Initialize the local symtable
-    init_symtable(local_symtable);
-    return st_stack_push(parser->var_st_stack, local_symtable); // Push the local symtable to the variable symtable stack
+int create_local_symtable(Parser_T *parser){
+    return st_stack_push_scope(parser->var_st_stack); // Push the local scope to the variable symtable stack
+}
+
+/**
+ * @brief Interns a string literal so it can be compared with the IDs of the tokens.
+ *
+ * @param str String literal to be interned
+ * @returns The atom of the string, NULL if the allocation failed
+ */
+static char *intern_literal(const char *str){
+    return atom_intern(&atoms, str, strlen(str));
 }
 
 /**
@@ -220,6 +259,10 @@ int create_local_symtable(Parser_T *parser, TTree *local_symtable){
  * @returns The correct error return code (0 if success)
  */
 int predef_functions_insert(Parser_T *parser){
+    // The parameters without a name are compared with the atom of '_'
+    if ((parser->underscore_atom = intern_literal("_")) == NULL)
+        return COMPILER_ERR_INTER; // Allocation failed
+
     // Gradually insert all the pre-defined functions into the global symtable
     for (int i = 0; i < PREDEF_FUNCTIONS_CNT; i++){
         TData_var var_data; // The variable data will be empty (we're inserting a function)
@@ -321,9 +364,20 @@ int predef_functions_insert(Parser_T *parser){
                 break;
         }
 
+        // The names and IDs of the parameters are compared as atoms
+        for (int j = 0; func_data.parameters != NULL && j < func_data.parameter_count; j++){
+            func_data.parameters[j].name = intern_literal(func_data.parameters[j].name);
+            func_data.parameters[j].id = intern_literal(func_data.parameters[j].id);
+            if (func_data.parameters[j].name == NULL || func_data.parameters[j].id == NULL)
+                return COMPILER_ERR_INTER; // Allocation failed
+        }
+
         func_data.ret_type = predef_functions_ret_type[i]; // Save the correct return type
+        parser->predef_atoms[i] = intern_literal(predef_functions[i]);
+        if (parser->predef_atoms[i] == NULL)
+            return COMPILER_ERR_INTER; // Allocation failed
         // Insert the correct function into the global symtable
-        if (insert_symbol(&parser->global_func_symbtable->root, predef_functions[i], FUNCTION, var_data, func_data, parser->global_func_symbtable) == 0) // Symbol insertion failed
+        if (insert_symbol(parser->global_func_symbtable, parser->predef_atoms[i], FUNCTION, var_data, func_data) == 0) // Symbol insertion failed
             return COMPILER_ERR_INTER; // Malloc failed
     }
     return NO_ERR;
@@ -342,7 +396,7 @@ int check_unique_name(TData_func *func_data){
 
     // More than 1 function parameter
     for (int i = 0; i < func_data->parameter_count - 1; i++){
-        if (strcmp(func_data->parameters[i].name, parser.current_token.token_value.dyn_str.dynamic_str) == 0){
+        if (func_data->parameters[i].name == parser.current_token.token_value.str){ // Atoms are compared by their addresses
             return SEMANTIC_ERR_A; // The function parameter name is not unique
         }
     }
@@ -363,7 +417,7 @@ int check_unique_id(TData_func *func_data){
 
     // More than 1 function parameter
     for (int i = 0; i < func_data->parameter_count - 1; i++){
-        if (strcmp(func_data->parameters[i].id, parser.current_token.token_value.dyn_str.dynamic_str) == 0){
+        if (func_data->parameters[i].id == parser.current_token.token_value.str){
             return SEMANTIC_ERR_A; // The function parameter ID is not unique
         }
     }
@@ -464,7 +518,7 @@ int parse_params_list_n(TData_func *func_data, TData_var *var_data){
         TOKENCHECK(&parser.current_token)
 
          // Check if the token is a variable ID and if the parameter ID and the parametr name aren't identical
-        if (parser.current_token.token_type != TOKEN_VAR_ID || strcmp(parser.current_token.token_value.dyn_str.dynamic_str, func_data->parameters[func_data->parameter_count - 1].name) == 0){
+        if (parser.current_token.token_type != TOKEN_VAR_ID || parser.current_token.token_value.str == func_data->parameters[func_data->parameter_count - 1].name){
             return SEMANTIC_ERR_A;
         }
 
@@ -472,7 +526,7 @@ int parse_params_list_n(TData_func *func_data, TData_var *var_data){
         RETURNCHECK(check_unique_id(func_data))
 
         // Save tha parameter ID
-        func_data->parameters[func_data->parameter_count - 1].id = parser.current_token.token_value.dyn_str.dynamic_str; 
+        func_data->parameters[func_data->parameter_count - 1].id = parser.current_token.token_value.str; 
 
         /* Get the next token */
         TOKENCHECK(&parser.current_token)
@@ -619,10 +673,10 @@ int parse_param_name(TData_func *func_data, TData_var *var_data){
         // The parameter name is an actual unique ID
         RETURNCHECK(check_unique_name(func_data)) // Check if a parameter with this name doesn't exist already
         // Save the parameter name
-        func_data->parameters[func_data->parameter_count - 1].name = parser.current_token.token_value.dyn_str.dynamic_str;
+        func_data->parameters[func_data->parameter_count - 1].name = parser.current_token.token_value.str;
     } else if (parser.current_token.token_type == TOKEN_UNDER_L){
         // The parameter name is a '_' symbol
-        func_data->parameters[func_data->parameter_count - 1].name = "_";
+        func_data->parameters[func_data->parameter_count - 1].name = parser.underscore_atom;
     } else  {
         // The parameter name is invalid
         return SYNTAX_ERR;
@@ -660,11 +714,11 @@ int parse_params_list(TData_func *func_data, TData_var *var_data){
     TOKENCHECK(&parser.current_token)
 
     // Check if the token is a variable ID and if the parameter ID and parameter name aren't identical
-    if (parser.current_token.token_type != TOKEN_VAR_ID || strcmp(parser.current_token.token_value.dyn_str.dynamic_str, func_data->parameters[func_data->parameter_count - 1].name) == 0)
+    if (parser.current_token.token_type != TOKEN_VAR_ID || parser.current_token.token_value.str == func_data->parameters[func_data->parameter_count - 1].name)
         return SEMANTIC_ERR_OTHER;
 
     // Save the parameter ID
-    func_data->parameters[func_data->parameter_count - 1].id = parser.current_token.token_value.dyn_str.dynamic_str; 
+    func_data->parameters[func_data->parameter_count - 1].id = parser.current_token.token_value.str; 
 
     /* Get the next token */
     TOKENCHECK(&parser.current_token)
@@ -705,11 +759,11 @@ int parse_function_definition(){
         return SYNTAX_ERR;
 
     // Check if function with the same name isn't defined already
-    if (search_symbol(parser.global_func_symbtable->root, parser.current_token.token_value.dyn_str.dynamic_str) != NULL)
+    if (search_symbol(parser.global_func_symbtable, parser.current_token.token_value.str) != NULL)
         return SEMANTIC_ERR_A; // Function redefinition
     
     // Save the function ID for later
-    char *func_ID = parser.current_token.token_value.dyn_str.dynamic_str;
+    char *func_ID = parser.current_token.token_value.str;
 
     // Skip the execution of this function
     // Execute this function only when called
@@ -734,7 +788,7 @@ int parse_function_definition(){
     RETURNCHECK(parse_return_type(&func_data, &var_data))
 
     // Insert the function into the global function symtable
-    if (insert_symbol(&parser.global_func_symbtable->root, func_ID, FUNCTION, var_data, func_data, parser.global_func_symbtable) == 0)
+    if (insert_symbol(parser.global_func_symbtable, func_ID, FUNCTION, var_data, func_data) == 0)
         return COMPILER_ERR_INTER;
 
     if (parser.current_token.token_type != TOKEN_L_BRAC)
@@ -743,8 +797,7 @@ int parse_function_definition(){
     parser.return_detected = false;
 
     // Create a new empty local symtable and push it to the top of the variable symtable stack
-    TTree *local_symtable = (TTree *) malloc(sizeof(TTree));
-    init_symtable(local_symtable);
+    RETURNCHECK(create_local_symtable(&parser))
     for (int i = 0; i < func_data.parameter_count; i++){
         TData_var var_data_arg;           // Function argument data
         TData_func fnc_data_tmp;          // The function data
@@ -752,10 +805,8 @@ int parse_function_definition(){
         var_data_arg.type = func_data.parameters[i].type;
         var_data_arg.init = false;
         var_data_arg.is_param = true;
-        if(insert_symbol(&local_symtable->root, func_data.parameters[i].id, VARIABLE, var_data_arg, fnc_data_tmp, local_symtable) == 0)
-            return COMPILER_ERR_INTER;
+        RETURNCHECK(st_stack_insert(parser.var_st_stack, func_data.parameters[i].id, VARIABLE, var_data_arg, fnc_data_tmp))
     }
-    RETURNCHECK(st_stack_push(parser.var_st_stack, local_symtable))
 
     /* Get the next token */
     TOKENCHECK(&parser.current_token)
@@ -812,16 +863,23 @@ int parse_var_assign(TData_func *func_data, TData_var *var_data){
             printf("@__%s__\n", parser.var_name);
         }
 
-    // Call the expression parser to handle the expression
-        parser.EOL_skip = false;
         parser.var_data = var_data; // Save the variable data for later
-        parser.call_new_token = true;
         parser.current_rule = VAR_DEF;
         parser.lvalue = parser.current_token;
-        RETURNCHECK(expression_parse(&parser))
 
-        parser.EOL_skip = true;
-        parser.call_new_token = true;
+        // The token right after '=' tells a function call from an expression
+        Token_Type_T next_type;
+        RETURNCHECK(token_stream_peek(parser.tokens, 0, &next_type))
+        if (next_type == TOKEN_FUNC_ID){
+            /* Get the next token */
+            TOKENCHECK(&parser.current_token)
+            parser.exp_assigned = false; // The value of the call is pushed to the data stack
+        } else {
+            // Call the expression parser to handle the expression
+            parser.exp_dest = parser.lvalue.token_value.str;
+            RETURNCHECK(expression_parse(&parser))
+        }
+
         var_data->init = true;
 
         if (parser.current_token.token_type == TOKEN_EOL || parser.current_token.token_type == TOKEN_R_PAR){
@@ -834,14 +892,16 @@ int parse_var_assign(TData_func *func_data, TData_var *var_data){
             parser.function_count++;
         }
 
-        if(parser.in_while == true){
+        if(parser.exp_assigned == true){
+            // The expression has been assigned to the variable already (three-address code)
+        }else if(parser.in_while == true){
             // If in while, use global frame, else choose based on parser.inside_main
-            printf("POPS GF@__%s__\n", parser.lvalue.token_value.dyn_str.dynamic_str);
+            printf("POPS GF@__%s__\n", parser.lvalue.token_value.str);
             }else{
             if(parser.inside_main == 0){
-                printf("POPS LF@__%s__\n", parser.lvalue.token_value.dyn_str.dynamic_str);
+                printf("POPS LF@__%s__\n", parser.lvalue.token_value.str);
             }else if(parser.inside_main == 1){
-                printf("POPS GF@__%s__\n", parser.lvalue.token_value.dyn_str.dynamic_str);
+                printf("POPS GF@__%s__\n", parser.lvalue.token_value.str);
             }
         }
         return NO_ERR;
@@ -921,6 +981,8 @@ int parse_variable_definition(){
     // Create a helping structure that holds all the variable information (such as variable name, variable type, ....)
     TData_func func_data; // The empty function data
     TData_var var_data;   // The variable data
+    var_data.init = false;      // The variable is defined by the assignment
+    var_data.is_param = false;
 
     /* Parse the variable definition type */
     RETURNCHECK(parse_var_def_type(&func_data, &var_data))
@@ -931,11 +993,11 @@ int parse_variable_definition(){
     if (parser.current_token.token_type != TOKEN_VAR_ID)
         return SYNTAX_ERR;
 
-    if (search_symbol(parser.var_st_stack->stack_head->symtable_item->root, parser.current_token.token_value.dyn_str.dynamic_str) != NULL)
+    if (search_st_stack_top(parser.var_st_stack, parser.current_token.token_value.str) != NULL)
         return SEMANTIC_ERR_A; // Variable with the same ID exists already
     
     // Save the variable ID for later
-    parser.var_name = parser.current_token.token_value.dyn_str.dynamic_str;
+    parser.var_name = parser.current_token.token_value.str;
 
     /* Get the next token */
     TOKENCHECK(&parser.current_token)
@@ -946,8 +1008,7 @@ int parse_variable_definition(){
     /* Parse the variable assign */
     RETURNCHECK(parse_var_assign(&func_data, &var_data))
 
-    if (insert_symbol(&parser.var_st_stack->stack_head->symtable_item->root, parser.var_name, VARIABLE, var_data, func_data, parser.var_st_stack->stack_head->symtable_item) == 0)
-        return COMPILER_ERR_INTER;
+    RETURNCHECK(st_stack_insert(parser.var_st_stack, parser.var_name, VARIABLE, var_data, func_data))
 
     return NO_ERR;
 }
@@ -966,7 +1027,7 @@ int parse_assignment(){
     if (parser.current_token.token_type != TOKEN_VAR_ID)
         return SYNTAX_ERR;
 
-    TNode *searched_node = search_st_stack(parser.var_st_stack, parser.current_token.token_value.dyn_str.dynamic_str); 
+    TNode *searched_node = resolve_symbol(&parser, &parser.current_token);
     if (searched_node == NULL) // The variable is not defined
         return SEMANTIC_ERR_C;
 
@@ -976,15 +1037,18 @@ int parse_assignment(){
     if (parser.current_token.token_type != TOKEN_ASSIGN)
         return SYNTAX_ERR;
 
-    if (searched_node->variable_data.constant == true && searched_node->variable_data.init == true)
+    if (searched_node->data.variable_data.constant == true && searched_node->data.variable_data.init == true)
         return SEMANTIC_ERR_OTHER; // Assignment to a constant
 
 
-    /* Get the next token */
-    TOKENCHECK(&parser.current_token)
+    Token_Type_T next_type;
+    RETURNCHECK(peek_token(&next_type))
+
+    if (next_type == TOKEN_FUNC_ID){ // Assignment of a function
+        /* Get the next token */
+        TOKENCHECK(&parser.current_token)
 
-    if (parser.current_token.token_type == TOKEN_FUNC_ID){ // Assignment of a function
-        TNode *searched_func = search_symbol(parser.global_func_symbtable->root, parser.current_token.token_value.dyn_str.dynamic_str);
+        TNode *searched_func = search_symbol(parser.global_func_symbtable, parser.current_token.token_value.str);
         if (searched_func == NULL) // The function is NOT defined
             return SEMANTIC_ERR_A;
 
@@ -995,25 +1059,23 @@ int parse_assignment(){
         RETURNCHECK(parse_function_call())
     } else { // Assignment of a variable
         // Call the expression parser to handle the expression
-        parser.call_new_token = false;
-        parser.EOL_skip = false;
         parser.current_rule = ASSIGNMENT;
-        parser.var_data = &(searched_node->variable_data);
+        parser.var_data = &(searched_node->data.variable_data);
+        parser.exp_dest = searched_node->id;
         RETURNCHECK(expression_parse(&parser))
 
-        parser.EOL_skip = true;
-        parser.call_new_token = true;
-
-        // Retrieve value of an assignment
-        printf("POPS ");
-        if(parser.in_while == true){
-            printf("GF@__%s__\n", searched_node->id);
-        }else{
-            if(parser.inside_main == 0){
-                printf("LF@__%s__", searched_node->id);
+        // Retrieve value of an assignment (unless the expression has been assigned to the variable already)
+        if(parser.exp_assigned == false){
+            printf("POPS ");
+            if(parser.in_while == true){
+                printf("GF@__%s__\n", searched_node->id);
             }else{
-                printf("GF@__%s__", searched_node->id);}
-            printf("\n");
+                if(parser.inside_main == 0){
+                    printf("LF@__%s__", searched_node->id);
+                }else{
+                    printf("GF@__%s__", searched_node->id);}
+                printf("\n");
+            }
         }
         if (parser.current_token.token_type == TOKEN_EOL || parser.current_token.token_type == TOKEN_R_PAR)
             /* Get the next token */
@@ -1033,7 +1095,6 @@ int parse_while_statement(){
     int result; // Variable that holds the return value
 
     // Call the expression parser to handle the expression
-    parser.EOL_skip = false;
     parser.current_rule = WHILE_STMNT;
     RETURNCHECK(expression_parse(&parser))
 
@@ -1045,7 +1106,6 @@ int parse_while_statement(){
     parser.in_while = true;
     printf("JUMP while_end%d\nLABEL while_true%d\n", parser.while_count, parser.while_count);
     parser.inside_main = false; // We're inside the while statement
-    parser.EOL_skip = true;
 
     if (parser.current_token.token_type == TOKEN_EOL || parser.current_token.token_type == TOKEN_R_PAR)
         /* Get the next token */
@@ -1055,9 +1115,7 @@ int parse_while_statement(){
         return SYNTAX_ERR;
 
     // Create a new empty local symtable and push it to the top of the variable symtable stack
-    TTree *local_symtable = (TTree *) malloc(sizeof(TTree));
-    init_symtable(local_symtable);
-    RETURNCHECK(st_stack_push(parser.var_st_stack, local_symtable))
+    RETURNCHECK(create_local_symtable(&parser))
 
     // Create a new local codegen frame
     printf("CREATEFRAME\n");
@@ -1103,12 +1161,10 @@ int parse_if_statement(){
     int result; // Variable that holds the return value
 
     // Call the expression parser to handle the expression
-    parser.EOL_skip = false;
     parser.current_rule = IF_STMNT;
     RETURNCHECK(expression_parse(&parser))
 
     parser.inside_main = false; // We're inside the if statement
-    parser.EOL_skip = true;
     
     if (parser.current_token.token_type == TOKEN_EOL || parser.current_token.token_type == TOKEN_R_PAR)
         /* Get the next token */
@@ -1118,9 +1174,7 @@ int parse_if_statement(){
         return SYNTAX_ERR;
 
     // Create a new empty local symtable and push it to the top of the variable symtable stack
-    TTree *local_symtable = (TTree *) malloc(sizeof(TTree));
-    init_symtable(local_symtable);
-    RETURNCHECK(st_stack_push(parser.var_st_stack, local_symtable))
+    RETURNCHECK(create_local_symtable(&parser))
 
     // Create a new local codegen frame
     printf("CREATEFRAME\n");
@@ -1157,9 +1211,7 @@ int parse_if_statement(){
     printf("JUMP end%d\nLABEL if_not_passed%d\n", parser.if_count, parser.if_count);
     
     // Create a new empty local symtable and push it to the top of the variable symtable stack
-    TTree *local_symtable2 = (TTree *) malloc(sizeof(TTree));
-    init_symtable(local_symtable2);
-    RETURNCHECK(st_stack_push(parser.var_st_stack, local_symtable2))
+    RETURNCHECK(create_local_symtable(&parser))
 
     // Create a new local codegen frame
     printf("CREATEFRAME\n");
@@ -1205,11 +1257,11 @@ int parse_input_param_name(TNode *searched_node, int *loaded_paramas_cnt, Argume
 
     
     // Save the function argument name
-    input_params_data[*loaded_paramas_cnt].param_name = parser.current_token.token_value.dyn_str.dynamic_str;  
+    input_params_data[*loaded_paramas_cnt].param_name = parser.current_token.token_value.str;  
 
     // The parametr has an actual name in the function definition (not "_")
-    if (strcmp(searched_node->function_data.parameters[*loaded_paramas_cnt].name, "_") != 0){
-        if (strcmp(input_params_data[*loaded_paramas_cnt].param_name, searched_node->function_data.parameters[*loaded_paramas_cnt].name) != 0){
+    if (searched_node->data.function_data.parameters[*loaded_paramas_cnt].name != parser.underscore_atom){
+        if (input_params_data[*loaded_paramas_cnt].param_name != searched_node->data.function_data.parameters[*loaded_paramas_cnt].name){
             return SEMANTIC_ERR_B; // Wrong argument name
         }
         /* Get the next token */
@@ -1244,7 +1296,7 @@ int parse_input_param_name(TNode *searched_node, int *loaded_paramas_cnt, Argume
 int parse_input_params_list_n(TNode *searched_node, int *loaded_paramas_cnt, Arguments_Data_T *input_params_data){
     int result; // Variable that holds the return value
 
-    if (*loaded_paramas_cnt >= searched_node->function_data.parameter_count) // Wrong amount of function arguments
+    if (*loaded_paramas_cnt >= searched_node->data.function_data.parameter_count) // Wrong amount of function arguments
         return SEMANTIC_ERR_B;
 
     /* Parse the input parameter name */
@@ -1260,7 +1312,7 @@ int parse_input_params_list_n(TNode *searched_node, int *loaded_paramas_cnt, Arg
 
     if (parser.current_token.token_type == TOKEN_R_PAR){
         // Send parameters to function via TF
-        if(searched_node->function_data.parameter_count > 0){
+        if(searched_node->data.function_data.parameter_count > 0){
             printf("CREATEFRAME\n");
             printf("PUSHFRAME\n");
             printf("CREATEFRAME\n");
@@ -1280,7 +1332,7 @@ int parse_input_params_list_n(TNode *searched_node, int *loaded_paramas_cnt, Arg
                     printf("MOVE TF@_p%d_ float@%a\n", i,  input_params_data[i].term.token_value.num_decimal);
                 }else if(input_params_data[i].term.token_type == TOKEN_STR || input_params_data[i].term.token_type == TOKEN_M_LINE_STR){
                     printf("MOVE TF@_p%d_ string@", i);
-                    print_string_in_ifjcode_form(input_params_data[i].term.token_value.dyn_str.dynamic_str);
+                    print_string_in_ifjcode_form(input_params_data[i].term.token_value.str);
                     printf("\n");
                 }
             }
@@ -1288,7 +1340,7 @@ int parse_input_params_list_n(TNode *searched_node, int *loaded_paramas_cnt, Arg
 
         // Call function
         // Built-in function write is handled separatelly
-        if(strcmp(parser.current_token.token_value.dyn_str.dynamic_str, "write") != 0){
+        if(searched_node->id != parser.predef_atoms[PREDEF_WRITE]){
             printf("CALL $_%s_\n", searched_node->id);
         }
         return NO_ERR;
@@ -1313,7 +1365,7 @@ int parse_input_params_list_n(TNode *searched_node, int *loaded_paramas_cnt, Arg
 int parse_input_params_list(TNode *searched_node, int *loaded_params_cnt, Arguments_Data_T *input_params_data){
     int result; // Variable that holds the return value
  
-    if (*loaded_params_cnt >= searched_node->function_data.parameter_count) // Wrong amount of function arguments
+    if (*loaded_params_cnt >= searched_node->data.function_data.parameter_count) // Wrong amount of function arguments
         return SEMANTIC_ERR_B;
 
     /* Parse the input parameter name */
@@ -1329,20 +1381,20 @@ int parse_input_params_list(TNode *searched_node, int *loaded_params_cnt, Argume
     
     if (parser.current_token.token_type == TOKEN_R_PAR){
         // Handle built in functions with parammeters
-        if(strcmp(searched_node->id, "Int2Double") == 0){
+        if(searched_node->id == parser.predef_atoms[PREDEF_INT2DOUBLE]){
             printf("CREATEFRAME\nDEFVAR TF@$_builtin_return_%d\nINT2FLOAT TF@$_builtin_return_%d int@%d\nPUSHS TF@$_builtin_return_%d\n", 
             parser.builtin_function_count, parser.builtin_function_count, input_params_data[0].term.token_value.num_integer, parser.builtin_function_count);
             parser.builtin_function_count++;
-        }else if(strcmp(searched_node->id, "Double2Int") == 0){
+        }else if(searched_node->id == parser.predef_atoms[PREDEF_DOUBLE2INT]){
             printf("CREATEFRAME\nDEFVAR TF@$_builtin_return_%d\nFLOAT2INT TF@$_builtin_return_%d float@%a\nPUSHS TF@$_builtin_return_%d\n", 
             parser.builtin_function_count, parser.builtin_function_count, input_params_data[0].term.token_value.num_decimal, parser.builtin_function_count);
             parser.builtin_function_count++;
-        }else if(strcmp(searched_node->id, "length") == 0){
+        }else if(searched_node->id == parser.predef_atoms[PREDEF_LENGTH]){
             printf("CREATEFRAME\nDEFVAR TF@$_builtin_return_%d\nSTRLEN TF@$_builtin_return_%d ", parser.builtin_function_count, parser.builtin_function_count);
             get_frame(input_params_data[0].term, &parser);
             printf("\nPUSHS TF@$_builtin_return_%d\n", parser.builtin_function_count);
             parser.builtin_function_count++;
-        }else if(strcmp(searched_node->id, "ord") == 0){
+        }else if(searched_node->id == parser.predef_atoms[PREDEF_ORD]){
             printf("CREATEFRAME\nDEFVAR TF@$_builtin_return_%d\nDEFVAR GF@*tmp*\n", parser.builtin_function_count);
             printf("STRLEN GF@*tmp* ");
             get_frame(input_params_data[0].term, &parser);
@@ -1351,7 +1403,7 @@ int parse_input_params_list(TNode *searched_node, int *loaded_params_cnt, Argume
             printf("int@0\nSTRI2INT TF@$_builtin_return_%d TF@$_builtin_return_%d int@0\nPUSHS TF@$_builtin_return_%d\nJUMP ord_label%d_end\nLABEL ord_label%d\nMOVE TF@$_builtin_return_%d int@0\nPUSHS TF@$_builtin_return_%d\nLABEL ord_label%d_end\n",
             parser.builtin_function_count, parser.builtin_function_count, parser.builtin_function_count, parser.builtin_function_count, parser.builtin_function_count, parser.builtin_function_count, parser.builtin_function_count, parser.builtin_function_count);
             parser.builtin_function_count++;
-        }else if(strcmp(searched_node->id, "chr") == 0){
+        }else if(searched_node->id == parser.predef_atoms[PREDEF_CHR]){
             printf("CREATEFRAME\nDEFVAR TF@$_builtin_return_%d\n", parser.builtin_function_count);
             printf("INT2CHAR TF@$_builtin_return_%d ", parser.builtin_function_count);
             get_frame(input_params_data[0].term, &parser);
@@ -1360,7 +1412,7 @@ int parse_input_params_list(TNode *searched_node, int *loaded_params_cnt, Argume
         }else {
         // Handle user defined functions
             // Send parameters to function via TF
-            if(searched_node->function_data.parameter_count > 0){
+            if(searched_node->data.function_data.parameter_count > 0){
                 printf("CREATEFRAME\n");
                 printf("PUSHFRAME\n");
                 printf("CREATEFRAME\n");
@@ -1380,7 +1432,7 @@ int parse_input_params_list(TNode *searched_node, int *loaded_params_cnt, Argume
                         printf("MOVE TF@_p%d_ float@%a\n", i,  input_params_data[i].term.token_value.num_decimal);
                     }else if(input_params_data[i].term.token_type == TOKEN_STR || input_params_data[i].term.token_type == TOKEN_M_LINE_STR){
                         printf("MOVE TF@_p%d_ string@", i);
-                        print_string_in_ifjcode_form(input_params_data[i].term.token_value.dyn_str.dynamic_str);
+                        print_string_in_ifjcode_form(input_params_data[i].term.token_value.str);
                         printf("\n");
                     }
                 }
@@ -1412,28 +1464,28 @@ int parse_function_call(){
     int result; // Variable that holds the return value
 
     // Search for the function
-    TNode *searched_node = search_symbol(parser.global_func_symbtable->root, parser.current_token.token_value.dyn_str.dynamic_str);
+    TNode *searched_node = search_symbol(parser.global_func_symbtable, parser.current_token.token_value.str);
     if (searched_node == NULL)
         return SEMANTIC_ERR_A; // The function is NOT defined
 
     
-    if(searched_node->function_data.parameter_count == 0){
+    if(searched_node->data.function_data.parameter_count == 0){
         // Call function with no params
         // Functions with params are called in parse_input_params_list()
         // Builtin functions without parameters are handeled separatelly
-        if(strcmp(searched_node->id, "readString") == 0){ // readString()
+        if(searched_node->id == parser.predef_atoms[PREDEF_READ_STRING]){ // readString()
             printf("CREATEFRAME\nDEFVAR TF@$_builtin_return_%d\n", parser.builtin_function_count);
             printf("READ TF@$_builtin_return_%d string\nPUSHS TF@$_builtin_return_%d\n", parser.builtin_function_count, parser.builtin_function_count);
             parser.builtin_function_count++;
-        }else if(strcmp(searched_node->id, "readInt") == 0){ // readInt()
+        }else if(searched_node->id == parser.predef_atoms[PREDEF_READ_INT]){ // readInt()
             printf("CREATEFRAME\nDEFVAR TF@$_builtin_return_%d\n", parser.builtin_function_count);
             printf("READ TF@$_builtin_return_%d int\nPUSHS TF@$_builtin_return_%d\n", parser.builtin_function_count, parser.builtin_function_count);
             parser.builtin_function_count++;
-        }else if(strcmp(searched_node->id, "readDouble") == 0){ // readDouble()
+        }else if(searched_node->id == parser.predef_atoms[PREDEF_READ_DOUBLE]){ // readDouble()
             printf("CREATEFRAME\nDEFVAR TF@$_builtin_return_%d\n", parser.builtin_function_count);
             printf("READ TF@$_builtin_return_%d float\nPUSHS TF@$_builtin_return_%d\n", parser.builtin_function_count, parser.builtin_function_count);
             parser.builtin_function_count++;
-        }else if(strcmp(searched_node->id, "write") != 0){
+        }else if(searched_node->id != parser.predef_atoms[PREDEF_WRITE]){
             printf("CREATEFRAME\nPUSHFRAME\nCREATEFRAME\n");
             printf("CALL $_%s_\n", searched_node->id);
         }
@@ -1449,7 +1501,7 @@ int parse_function_call(){
     TOKENCHECK(&parser.current_token)
 
     if (parser.current_token.token_type == TOKEN_R_PAR){
-        if (searched_node->function_data.parameter_count != 0) // Wrong amount of function arguments
+        if (searched_node->data.function_data.parameter_count != 0) // Wrong amount of function arguments
             return SEMANTIC_ERR_B;
         /* Get the next token */
         TOKENCHECK(&parser.current_token)
@@ -1457,20 +1509,20 @@ int parse_function_call(){
     }
 
     // Special function to handle the pre-defined function "write"
-    if (strcmp(searched_node->id, "write") == 0){
+    if (searched_node->id == parser.predef_atoms[PREDEF_WRITE]){
         RETURNCHECK(handle_write())
         return NO_ERR;
     }
 
     // Load the function arguments
     Arguments_Data_T *input_params_data;      
-    input_params_data = (Arguments_Data_T *) malloc(sizeof(Arguments_Data_T) * searched_node->function_data.parameter_count);
+    input_params_data = (Arguments_Data_T *) malloc(sizeof(Arguments_Data_T) * searched_node->data.function_data.parameter_count);
     int loaded_params_cnt = 0;
 
     /* Parse the parameters list */
     RETURNCHECK(parse_input_params_list(searched_node, &loaded_params_cnt, input_params_data))
 
-    if (loaded_params_cnt != searched_node->function_data.parameter_count) // Wrong amount of function arguments
+    if (loaded_params_cnt != searched_node->data.function_data.parameter_count) // Wrong amount of function arguments
         return SEMANTIC_ERR_B;
 
     /* Get the next token */
@@ -1490,32 +1542,30 @@ int parse_function_call(){
 int parse_return_option(TNode *searched_node){
     int result; // Variable that holds the return value
 
-    /* Get the next token */
-    TOKENCHECK(&parser.current_token)
+    Token_Type_T next_type;
+    RETURNCHECK(peek_token(&next_type))
 
-    if (parser.current_token.token_type == TOKEN_R_BRAC){ // Return (void)
-        if (searched_node->function_data.ret_type != VOID){ // Function doesn't return anything but should
+    if (next_type == TOKEN_R_BRAC){ // Return (void)
+        /* Get the next token */
+        TOKENCHECK(&parser.current_token)
+
+        if (searched_node->data.function_data.ret_type != VOID){ // Function doesn't return anything but should
             return SYNTAX_ERR; 
         }
     } else { // Return expression
-        if (searched_node->function_data.ret_type == VOID){ // Void function should NOT return anything
+        if (searched_node->data.function_data.ret_type == VOID){ // Void function should NOT return anything
             return SEMANTIC_ERR_D;
         }
 
         // Call the expression parser to handle the expression
-        parser.call_new_token = false;
-        parser.EOL_skip = false;
         parser.current_rule = RETURN;
         RETURNCHECK(expression_parse(&parser))
 
-        parser.EOL_skip = true;
-
     if (parser.current_token.token_type == TOKEN_EOL || parser.current_token.token_type == TOKEN_R_PAR)
         /* Get the next token */
         TOKENCHECK(&parser.current_token)
     }
 
-    parser.call_new_token = true;
     return NO_ERR;
 }
 
@@ -1534,7 +1584,7 @@ int parse_function_return(){
         return SYNTAX_ERR;
 
     // Search for the function
-    TNode *searched_node = search_symbol(parser.global_func_symbtable->root, parser.current_func_name);
+    TNode *searched_node = search_symbol(parser.global_func_symbtable, parser.current_func_name);
     if (searched_node == NULL) // The function is NOT defined
         return SEMANTIC_ERR_A; 
 
@@ -1630,6 +1680,9 @@ int parse_program_eof(){
     if (parser.current_token.token_type != TOKEN_EOF) // The current token is NOT the end of the file
         return SYNTAX_ERR;
 
+    // Define the temporary variables of the expressions
+    exp_tree_epilogue(parser.exp_tree);
+
     // Clean all the allocated memory
     free(parser.global_func_symbtable);
     free(parser.global_var_symbtable);
@@ -1666,13 +1719,11 @@ int parse(){
     int result; // Variable that holds the return value
     
     /* Get the first token that isn't EOL */
-    parser.EOL_skip = true; // Indicates that we're skipping the EOL tokens
     TOKENCHECK(&parser.current_token)
 
     /* Create 2 global symtables for functions and variables, push the pre-defined functions to the global function symtable */
     RETURNCHECK(create_global_symtables(&parser))
 
-    parser.call_new_token = true; // Indicates that the expression parser should call for a new token
     parser.inside_main = true; // Indicates that we're inside the main (outside of a function body)
 
     // Set code generation values to 0 by default
@@ -1684,8 +1735,27 @@ int parse(){
     parser.in_while = 0;
     // Print IFJcode23 header
     printf(".IFJcode23\n");
+    exp_tree_prologue();
     
     /* Parse the main program */
     return parse_program();
 }
+
+/**
+ * @brief Parses the tokens scanned in advance.
+ *
+ * @param tokens Tokens of the whole source
+ * @returns The correct error code, 0 when success
+ */
+int parse_token_stream(Token_Stream_T *tokens){
+    parser.tokens = tokens;
+    int result = parse();
+    parser.tokens = NULL;
+    // The expression stack and tree are freed after the errors as well
+    stack_dispose(parser.exp_stack);
+    parser.exp_stack = NULL;
+    exp_tree_dispose(parser.exp_tree);
+    parser.exp_tree = NULL;
+    return result;
+}
 /* End of parser.c */
@@ -9,6 +9,7 @@
 #define PARSER_H
 
 #include "scanner.h"  
+#include "token_stream.h"  
 #include "symtable.h"  
 #include "symtable_stack.h"  
 #include <stdbool.h>  
@@ -17,17 +18,25 @@
 #define PREDEF_FUNCTIONS_CNT 10
 
 /*
- * / ****************************** TOKENCHECKHELP ******************************** \  
- * / Helping macro that checks if the token loaded from the scanner is valid or not \
+ * / ****************** Predef_Functions_T ******************* \
+ * / Enumeration that holds the indexes of pre-defined functions \
 */
-#define TOKENCHECKHELP(token)            \
-    result = get_token(token);           \
-    if (result != NO_ERR)                \
-        return result;                       
+typedef enum Predef_Functions {
+    PREDEF_READ_STRING,
+    PREDEF_READ_INT,
+    PREDEF_READ_DOUBLE,
+    PREDEF_WRITE,
+    PREDEF_INT2DOUBLE,
+    PREDEF_DOUBLE2INT,
+    PREDEF_LENGTH,
+    PREDEF_SUBSTRING,
+    PREDEF_ORD,
+    PREDEF_CHR
+} Predef_Functions_T;
 
 /*
- * / ********************************************** TOKENCHECK ************************************************* \  
- * / Macro that checks if the token loaded from the scanner is valid or not and skips the EOL tokens when needed \
+ * / ***************************************** TOKENCHECK ****************************************** \  
+ * / Macro that loads the next token that isn't EOL and checks if it's valid or not (returns if not) \
 */
 #define TOKENCHECK(token)                \
     result = skip_EOL(token);            \
@@ -73,21 +82,26 @@ typedef struct Arguments_Data {
 */
 typedef struct Parser {
     Token_T current_token;          // The current token from the scanner
+    Token_Stream_T *tokens;         // Tokens of the whole source (scanned in advance)
     TTree *global_var_symbtable;    // The global symtable for storing global variables
     TTree *global_func_symbtable;   // The global symtable for storing global variables
     Symtable_Stack_T *var_st_stack; // The symtable stack
+    struct Stack *exp_stack;        // The stack of the expression parser (NULL ~ not created yet, reused by all the expressions)
+    struct Exp_Tree *exp_tree;      // The tree of the expression being parsed (NULL ~ not created yet, reused by all the expressions)
     Rule_Type_T current_rule;       // The rule we're currently on
     TData_var *var_data;
+    char *exp_dest;                 // Variable the next expression is assigned to (NULL ~ its value is pushed to the data stack)
+    bool exp_assigned;              // Indicates if the last expression was assigned to exp_dest already (no POPS is needed)
 
     bool inside_main; // Indicates if we're inside of a function or not
-    bool EOL_skip; // Indicates if we're skipping the token for EOL or not
     bool has_return; // Indicates if function should have a return or not
     bool return_detected; // Indicates if a function return was detected or not
-    bool call_new_token; // Indicates if the expression parser should call for a new token or not
 
     char curr_type; // Indicates if we're parsing the function/variable type
     char *current_func_name;
     char *var_name;
+    char *predef_atoms[PREDEF_FUNCTIONS_CNT]; // Atoms of the pre-defined function names (Predef_Functions_T)
+    char *underscore_atom;                    // Atom of '_' (parameters without a name)
 
     int function_count; // Function counter for correct label generation
     int param_count;    // Parameter counter for passign parameters to a function correctly
@@ -100,11 +114,24 @@ typedef struct Parser {
 
 
 /*
- * / ***************** skip_EOL() ***************** \
- * / Function that skips the EOL tokens when needed \
+ * / ****************** skip_EOL() ******************* \
+ * / Function that loads the next token that isn't EOL \
 */
 int skip_EOL(Token_T *t);
 
+/*
+ * / ********************* next_token() ********************* \
+ * / Function that loads the next token (EOL tokens included) \
+*/
+int next_token(Token_T *t);
+
+/*
+ * / ********************** peek_token() ********************** \
+ * / Function that returns the type of the next token that isn't \
+ * / EOL without loading it (the expressions start after it)      \
+*/
+int peek_token(Token_Type_T *type);
+
 /*
  * / ******************* create_global_symtable() ******************* \
  * / Function that creates the global variable and function symtables \
@@ -121,7 +148,13 @@ int predef_functions_insert(Parser_T *parser);
  * / *********** create_local_symtable() ************ \
  * / Function that creates a new empty local symtable \
 */
-int create_local_symtable(Parser_T *parser, TTree *local_symtable);
+int create_local_symtable(Parser_T *parser);
+
+/*
+ * / ******************* resolve_symbol() ******************** \
+ * / Function that resolves the variable ID of a token only once \
+*/
+TNode *resolve_symbol(Parser_T *parser, Token_T *token);
 
 /*
  * / ************************ check_term() ************************* \
@@ -157,9 +190,15 @@ int check_unique_name(TData_func *func_data);
 /*  The following functions are based on the LL Grammar rules  */
 /* *********************************************************** */
 
-/*  Main parser function  */
+/*  Main parser function (parses parser.tokens)  */
 int parse();
 
+/*
+ * / ************** parse_token_stream() *************** \
+ * / Function that parses the tokens scanned in advance \
+*/
+int parse_token_stream(Token_Stream_T *tokens);
+
 /*  Rule 1: <program> ➔ <statement_list> <program_eof>  */
 int parse_program();
 
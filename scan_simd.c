@@ -0,0 +1,491 @@
+/* ******************************* scan_simd.c ******************************* */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Skip long runs of uninteresting bytes in the scanner        */
+/* *************************************************************************** */
+
+#include "scan_simd.h"   // header file
+#include <stdbool.h>
+#include <string.h>      // memcpy()
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(SCAN_NO_SIMD)
+#define SCAN_X86   // SSE2 is always there, AVX2 is checked at runtime
+#include <immintrin.h>
+#endif
+
+// Span kernels used by the scanner
+Scan_Span_Fn_T scan_span[SCAN_SPANS_CNT];
+
+// UTF-8 validation kernel
+Scan_Utf8_Fn_T scan_utf8_valid;
+
+// Bytes that end the span for every kind of span (used by the scalar kernels and the tails)
+static bool span_stop[SCAN_SPANS_CNT][256];
+
+/**
+ * Returns the length of the span using the lookup table.
+ *
+ * @param data Start of the span
+ * @param len Number of the loaded bytes
+ * @param stop Bytes that end the span
+ * @returns Index of the first byte that ends the span (len if there's none)
+ */
+static size_t scalar_span(const unsigned char *data, size_t len, const bool *stop){
+    size_t i = 0;
+    while (i < len && !stop[data[i]])
+        i++;
+    return i;
+}
+
+static size_t scalar_span_eol(const unsigned char *data, size_t len){
+    return scalar_span(data, len, span_stop[SCAN_SPAN_EOL]);
+}
+
+static size_t scalar_span_comment(const unsigned char *data, size_t len){
+    return scalar_span(data, len, span_stop[SCAN_SPAN_COMMENT]);
+}
+
+static size_t scalar_span_string(const unsigned char *data, size_t len){
+    return scalar_span(data, len, span_stop[SCAN_SPAN_STRING]);
+}
+
+static size_t scalar_span_id(const unsigned char *data, size_t len){
+    return scalar_span(data, len, span_stop[SCAN_SPAN_ID]);
+}
+
+static size_t scalar_span_blank(const unsigned char *data, size_t len){
+    return scalar_span(data, len, span_stop[SCAN_SPAN_BLANK]);
+}
+
+/**
+ * Checks one UTF-8 encoded character (RFC 3629, no overlong forms, surrogates or characters above U+10FFFF).
+ *
+ * @param data Data to be checked
+ * @param len Number of the loaded bytes
+ * @param i Index of the first byte of the character (moved after the character)
+ * @returns true if the character is valid, false otherwise
+ */
+static inline bool utf8_char_valid(const unsigned char *data, size_t len, size_t *i){
+    unsigned char c = data[*i];
+    size_t cnt;           // Number of the continuation bytes
+    unsigned char lo = 0x80, hi = 0xBF; // Range of the first continuation byte
+    if (c < 0x80){
+        (*i)++;
+        return true;
+    } else if (c >= 0xC2 && c <= 0xDF){
+        cnt = 1;
+    } else if (c >= 0xE0 && c <= 0xEF){
+        cnt = 2;
+        if (c == 0xE0) lo = 0xA0;       // Overlong form
+        else if (c == 0xED) hi = 0x9F;  // Surrogates
+    } else if (c >= 0xF0 && c <= 0xF4){
+        cnt = 3;
+        if (c == 0xF0) lo = 0x90;       // Overlong form
+        else if (c == 0xF4) hi = 0x8F;  // Above U+10FFFF
+    } else { // Continuation byte, overlong 2 byte form or invalid byte
+        return false;
+    }
+
+    if (len - *i <= cnt || data[*i + 1] < lo || data[*i + 1] > hi)
+        return false;
+    for (size_t j = 2; j <= cnt; j++){
+        if ((data[*i + j] & 0xC0) != 0x80)
+            return false;
+    }
+    *i += cnt + 1;
+    return true;
+}
+
+/**
+ * Checks if the data are valid UTF-8, 8 ASCII bytes at a time.
+ *
+ * @param data Data to be checked
+ * @param len Number of the bytes
+ * @returns true if the data are valid UTF-8, false otherwise
+ */
+static bool scalar_utf8_valid(const unsigned char *data, size_t len){
+    size_t i = 0;
+    while (i < len){
+        if (i + 8 <= len){ // ASCII is skipped by whole words
+            unsigned long long word;
+            memcpy(&word, data + i, 8);
+            if ((word & 0x8080808080808080ULL) == 0){
+                i += 8;
+                continue;
+            }
+        }
+        if (!utf8_char_valid(data, len, &i))
+            return false;
+    }
+    return true;
+}
+
+#ifdef SCAN_X86
+
+/* ******************************** SSE2 ******************************** */
+
+/**
+ * Marks the bytes within the range [lo, lo + cnt).
+ *
+ * @param v 16 loaded bytes
+ * @param lo Lowest byte of the range
+ * @param cnt Number of bytes in the range
+ * @returns 0xFF for the bytes within the range, 0x00 otherwise
+ */
+static inline __m128i sse2_in_range(__m128i v, char lo, char cnt){
+    __m128i shifted = _mm_sub_epi8(v, _mm_set1_epi8(lo)); // Unsigned x - lo < cnt
+    return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(cnt - 1)), shifted);
+}
+
+/**
+ * Marks the bytes that end the span.
+ *
+ * @param v 16 loaded bytes
+ * @param kind Kind of the span
+ * @returns Bit mask of the bytes that end the span
+ */
+static inline unsigned sse2_stop_mask(__m128i v, Scan_Span_T kind){
+    __m128i stop;
+    switch (kind){
+        case SCAN_SPAN_EOL:
+            stop = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+            break;
+        case SCAN_SPAN_COMMENT:
+            stop = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('*')), _mm_cmpeq_epi8(v, _mm_set1_epi8('/')));
+            break;
+        case SCAN_SPAN_STRING:
+            stop = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+            stop = _mm_or_si128(stop, _mm_cmpeq_epi8(_mm_and_si128(v, _mm_set1_epi8((char) 0xE0)), _mm_setzero_si128())); // < 32
+            break;
+        case SCAN_SPAN_ID:
+            stop = _mm_or_si128(sse2_in_range(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 26), sse2_in_range(v, '0', 10));
+            stop = _mm_andnot_si128(_mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8('_'))), _mm_set1_epi8((char) 0xFF));
+            break;
+        default: // SCAN_SPAN_BLANK
+            stop = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+            stop = _mm_andnot_si128(stop, _mm_set1_epi8((char) 0xFF));
+            break;
+    }
+    return (unsigned) _mm_movemask_epi8(stop);
+}
+
+/**
+ * Returns the length of the span, 16 bytes at a time.
+ *
+ * @param data Start of the span
+ * @param len Number of the loaded bytes
+ * @param kind Kind of the span
+ * @returns Index of the first byte that ends the span (len if there's none)
+ */
+static inline size_t sse2_span(const unsigned char *data, size_t len, Scan_Span_T kind){
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16){
+        unsigned mask = sse2_stop_mask(_mm_loadu_si128((const __m128i *) (data + i)), kind);
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    return i + scalar_span(data + i, len - i, span_stop[kind]); // The rest is shorter than 16 bytes
+}
+
+static size_t sse2_span_eol(const unsigned char *data, size_t len){
+    return sse2_span(data, len, SCAN_SPAN_EOL);
+}
+
+static size_t sse2_span_comment(const unsigned char *data, size_t len){
+    return sse2_span(data, len, SCAN_SPAN_COMMENT);
+}
+
+static size_t sse2_span_string(const unsigned char *data, size_t len){
+    return sse2_span(data, len, SCAN_SPAN_STRING);
+}
+
+static size_t sse2_span_id(const unsigned char *data, size_t len){
+    return sse2_span(data, len, SCAN_SPAN_ID);
+}
+
+static size_t sse2_span_blank(const unsigned char *data, size_t len){
+    return sse2_span(data, len, SCAN_SPAN_BLANK);
+}
+
+/**
+ * Checks if the data are valid UTF-8, 16 ASCII bytes at a time.
+ *
+ * @param data Data to be checked
+ * @param len Number of the bytes
+ * @returns true if the data are valid UTF-8, false otherwise
+ */
+static bool sse2_utf8_valid(const unsigned char *data, size_t len){
+    size_t i = 0;
+    while (i < len){
+        if (i + 16 <= len && _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) (data + i))) == 0){
+            i += 16; // 16 ASCII bytes
+            continue;
+        }
+        size_t block_end = (i + 16 < len) ? i + 16 : len;
+        while (i < block_end){ // Characters that start in the block are checked one by one
+            if (!utf8_char_valid(data, len, &i))
+                return false;
+        }
+    }
+    return true;
+}
+
+/* ******************************** AVX2 ******************************** */
+
+#define AVX2 __attribute__((target("avx2")))
+
+/**
+ * Marks the bytes within the range [lo, lo + cnt).
+ *
+ * @param v 32 loaded bytes
+ * @param lo Lowest byte of the range
+ * @param cnt Number of bytes in the range
+ * @returns 0xFF for the bytes within the range, 0x00 otherwise
+ */
+AVX2 static inline __m256i avx2_in_range(__m256i v, char lo, char cnt){
+    __m256i shifted = _mm256_sub_epi8(v, _mm256_set1_epi8(lo)); // Unsigned x - lo < cnt
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(cnt - 1)), shifted);
+}
+
+/**
+ * Marks the bytes that end the span.
+ *
+ * @param v 32 loaded bytes
+ * @param kind Kind of the span
+ * @returns Bit mask of the bytes that end the span
+ */
+AVX2 static inline unsigned avx2_stop_mask(__m256i v, Scan_Span_T kind){
+    __m256i stop;
+    switch (kind){
+        case SCAN_SPAN_EOL:
+            stop = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+            break;
+        case SCAN_SPAN_COMMENT:
+            stop = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')));
+            break;
+        case SCAN_SPAN_STRING:
+            stop = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+            stop = _mm256_or_si256(stop, _mm256_cmpeq_epi8(_mm256_and_si256(v, _mm256_set1_epi8((char) 0xE0)), _mm256_setzero_si256())); // < 32
+            break;
+        case SCAN_SPAN_ID:
+            stop = _mm256_or_si256(avx2_in_range(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 26), avx2_in_range(v, '0', 10));
+            stop = _mm256_andnot_si256(_mm256_or_si256(stop, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'))), _mm256_set1_epi8((char) 0xFF));
+            break;
+        default: // SCAN_SPAN_BLANK
+            stop = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+            stop = _mm256_andnot_si256(stop, _mm256_set1_epi8((char) 0xFF));
+            break;
+    }
+    return (unsigned) _mm256_movemask_epi8(stop);
+}
+
+/**
+ * Returns the length of the span, 32 bytes at a time.
+ *
+ * @param data Start of the span
+ * @param len Number of the loaded bytes
+ * @param kind Kind of the span
+ * @returns Index of the first byte that ends the span (len if there's none)
+ */
+AVX2 static inline size_t avx2_span(const unsigned char *data, size_t len, Scan_Span_T kind){
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32){
+        unsigned mask = avx2_stop_mask(_mm256_loadu_si256((const __m256i *) (data + i)), kind);
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    return i + sse2_span(data + i, len - i, kind); // The rest is shorter than 32 bytes
+}
+
+AVX2 static size_t avx2_span_eol(const unsigned char *data, size_t len){
+    return avx2_span(data, len, SCAN_SPAN_EOL);
+}
+
+AVX2 static size_t avx2_span_comment(const unsigned char *data, size_t len){
+    return avx2_span(data, len, SCAN_SPAN_COMMENT);
+}
+
+AVX2 static size_t avx2_span_string(const unsigned char *data, size_t len){
+    return avx2_span(data, len, SCAN_SPAN_STRING);
+}
+
+AVX2 static size_t avx2_span_id(const unsigned char *data, size_t len){
+    return avx2_span(data, len, SCAN_SPAN_ID);
+}
+
+AVX2 static size_t avx2_span_blank(const unsigned char *data, size_t len){
+    return avx2_span(data, len, SCAN_SPAN_BLANK);
+}
+
+/* Errors found by the UTF-8 lookup tables (the pair of the previous and the current byte) */
+#define UTF8_TOO_SHORT   (1 << 0)   // Lead byte followed by a lead byte or ASCII
+#define UTF8_TOO_LONG    (1 << 1)   // ASCII followed by a continuation byte
+#define UTF8_OVERLONG_3  (1 << 2)   // 11100000 100_____
+#define UTF8_TOO_LARGE   (1 << 3)   // 11110100 1001____ and above
+#define UTF8_SURROGATE   (1 << 4)   // 11101101 101_____
+#define UTF8_OVERLONG_2  (1 << 5)   // 1100000_ 10______
+#define UTF8_TOO_LARGE_1000 (1 << 6) // 11110101+ 1000____
+#define UTF8_OVERLONG_4  (1 << 6)   // 11110000 1000____
+#define UTF8_TWO_CONTS   ((char) 0x80) // Continuation byte that should be the 3rd/4th one (or is an error)
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+/**
+ * Returns the bytes of the block shifted by n, filled with the last bytes of the previous block.
+ *
+ * @param input 32 loaded bytes
+ * @param prev Previous 32 bytes
+ * @param n Shift (1, 2 or 3)
+ */
+#define AVX2_PREV(input, prev, n) _mm256_alignr_epi8((input), _mm256_permute2x128_si256((prev), (input), 0x21), 16 - (n))
+
+/**
+ * Finds the UTF-8 errors in the block (the lookup algorithm of Keiser and Lemire).
+ *
+ * @param input 32 loaded bytes
+ * @param prev Previous 32 bytes
+ * @returns Non zero bytes where there's an error
+ */
+AVX2 static inline __m256i avx2_utf8_errors(__m256i input, __m256i prev){
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    __m256i prev1 = AVX2_PREV(input, prev, 1);
+
+    // Errors of the pairs of bytes, looked up by the nibbles of both bytes
+    __m256i byte_1_high = _mm256_shuffle_epi8(_mm256_setr_epi8(
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2, UTF8_TOO_SHORT, UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2, UTF8_TOO_SHORT, UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+    __m256i byte_1_low = _mm256_shuffle_epi8(_mm256_setr_epi8(
+        UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4, UTF8_CARRY | UTF8_OVERLONG_2, UTF8_CARRY, UTF8_CARRY,
+        UTF8_CARRY | UTF8_TOO_LARGE, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4, UTF8_CARRY | UTF8_OVERLONG_2, UTF8_CARRY, UTF8_CARRY,
+        UTF8_CARRY | UTF8_TOO_LARGE, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        _mm256_and_si256(prev1, low_nibble));
+    __m256i byte_2_high = _mm256_shuffle_epi8(_mm256_setr_epi8(
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT),
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // 3rd and 4th bytes of the characters have to be continuation bytes (UTF8_TWO_CONTS is expected there)
+    __m256i third = _mm256_subs_epu8(AVX2_PREV(input, prev, 2), _mm256_set1_epi8((char) (0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(AVX2_PREV(input, prev, 3), _mm256_set1_epi8((char) (0xF0 - 0x80)));
+    __m256i must_be_cont = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char) 0x80));
+    return _mm256_xor_si256(must_be_cont, special);
+}
+
+/**
+ * Checks if the data are valid UTF-8, 32 bytes at a time.
+ *
+ * @param data Data to be checked
+ * @param len Number of the bytes
+ * @returns true if the data are valid UTF-8, false otherwise
+ */
+AVX2 static bool avx2_utf8_valid(const unsigned char *data, size_t len){
+    // Bytes that can't be the last ones (a lead byte that misses its continuation bytes)
+    const __m256i max_last = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char) (0xF0 - 1), (char) (0xE0 - 1), (char) (0xC0 - 1));
+    __m256i prev = _mm256_setzero_si256();
+    __m256i errors = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    unsigned char tail[32];
+
+    for (size_t i = 0; i < len; i += 32){
+        __m256i input;
+        if (i + 32 <= len){
+            input = _mm256_loadu_si256((const __m256i *) (data + i));
+        } else { // The last block is padded with ASCII
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, data + i, len - i);
+            input = _mm256_loadu_si256((const __m256i *) tail);
+        }
+
+        if (_mm256_movemask_epi8(input) == 0){ // ASCII only, the previous block must not have ended in a character
+            errors = _mm256_or_si256(errors, incomplete);
+        } else {
+            errors = _mm256_or_si256(errors, avx2_utf8_errors(input, prev));
+            incomplete = _mm256_subs_epu8(input, max_last);
+        }
+        prev = input;
+    }
+    errors = _mm256_or_si256(errors, incomplete); // Characters cut off by the end of the data
+    return _mm256_testz_si256(errors, errors);
+}
+
+#undef AVX2_PREV
+#undef AVX2
+
+#endif // SCAN_X86
+
+/**
+ * Fills the lookup tables of the scalar kernels.
+ */
+static void span_stop_init(){
+    for (int c = 0; c < 256; c++){
+        span_stop[SCAN_SPAN_EOL][c] = (c == '\n');
+        span_stop[SCAN_SPAN_COMMENT][c] = (c == '*' || c == '/');
+        span_stop[SCAN_SPAN_STRING][c] = (c == '"' || c == '\\' || c < 32);
+        span_stop[SCAN_SPAN_ID][c] = !((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_');
+        span_stop[SCAN_SPAN_BLANK][c] = !(c == ' ' || c == '\t');
+    }
+}
+
+/**
+ * Picks the fastest span kernels the CPU supports.
+ */
+void scan_simd_init(){
+    span_stop_init();
+
+    scan_span[SCAN_SPAN_EOL] = scalar_span_eol;
+    scan_span[SCAN_SPAN_COMMENT] = scalar_span_comment;
+    scan_span[SCAN_SPAN_STRING] = scalar_span_string;
+    scan_span[SCAN_SPAN_ID] = scalar_span_id;
+    scan_span[SCAN_SPAN_BLANK] = scalar_span_blank;
+    scan_utf8_valid = scalar_utf8_valid;
+
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")){
+        scan_span[SCAN_SPAN_EOL] = avx2_span_eol;
+        scan_span[SCAN_SPAN_COMMENT] = avx2_span_comment;
+        scan_span[SCAN_SPAN_STRING] = avx2_span_string;
+        scan_span[SCAN_SPAN_ID] = avx2_span_id;
+        scan_span[SCAN_SPAN_BLANK] = avx2_span_blank;
+        scan_utf8_valid = avx2_utf8_valid;
+    } else {
+        scan_span[SCAN_SPAN_EOL] = sse2_span_eol;
+        scan_span[SCAN_SPAN_COMMENT] = sse2_span_comment;
+        scan_span[SCAN_SPAN_STRING] = sse2_span_string;
+        scan_span[SCAN_SPAN_ID] = sse2_span_id;
+        scan_span[SCAN_SPAN_BLANK] = sse2_span_blank;
+        scan_utf8_valid = sse2_utf8_valid;
+    }
+#endif
+}
+/* End of scan_simd.c */
@@ -0,0 +1,48 @@
+/* ******************************* scan_simd.h ******************************* */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Header file for scan_simd.c                                 */
+/* *************************************************************************** */
+
+#ifndef SCAN_SIMD_H
+#define SCAN_SIMD_H
+
+#include <stddef.h>   // size_t
+#include <stdbool.h>
+
+/*
+ * / ************************** Scan_Span_T *************************** \
+ * / Enum that holds all the kinds of spans the scanner can skip at once \
+*/
+typedef enum Scan_Span {
+    /* ******************************************************************* */
+    /*        TYPE        ||           STOPS AT             ||    INDEX    */
+    /* ******************************************************************* */
+    SCAN_SPAN_EOL,        //   \n                           ||      0      */
+    SCAN_SPAN_COMMENT,    //   * /                          ||      1      */
+    SCAN_SPAN_STRING,     //   " \ and characters below 32  ||      2      */
+    SCAN_SPAN_ID,         //   anything but [a-zA-Z0-9_]    ||      3      */
+    SCAN_SPAN_BLANK,      //   anything but ' ' and \t      ||      4      */
+    SCAN_SPANS_CNT
+} Scan_Span_T;
+
+/* Function that returns the length of the span at the start of the data */
+typedef size_t (*Scan_Span_Fn_T)(const unsigned char *data, size_t len);
+
+/* Span kernels picked for the current CPU (SCAN_NO_SIMD forces the scalar ones) */
+extern Scan_Span_Fn_T scan_span[SCAN_SPANS_CNT];
+
+/* Function that checks if the data are valid UTF-8 */
+typedef bool (*Scan_Utf8_Fn_T)(const unsigned char *data, size_t len);
+
+/* UTF-8 validation kernel picked for the current CPU */
+extern Scan_Utf8_Fn_T scan_utf8_valid;
+
+/*
+ * / ********************** scan_simd_init() ********************** \
+ * / Function that picks the fastest span kernels the CPU supports \
+*/
+void scan_simd_init();
+
+#endif
+/* End of scan_simd.h */
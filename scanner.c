@@ -5,604 +5,817 @@
 /*  Functionality: Create tokens and send them to the parser when needed       */
 /* *************************************************************************** */
 
-#include "scanner.h"   // header file
-#include <stdlib.h>    // strtoul(), strtod(), ...
-#include <ctype.h>     // isdigit(), isalpha(), isspace(), ...
+#include "scanner.h"     // header file
+#include "scan_simd.h"   // scan_span[], scan_utf8_valid()
+#include "str_pool.h"    // Str_Pool_T
+#include "num_conv.h"    // num_to_uint(), num_to_double()
+#include <string.h>      // memcpy()
+
+// Scanner of the source set by set_file()
+Scanner_T scanner;
+
+// Atoms of all the identifiers (kept across the sources, the symtables point to them)
+Atom_Table_T atoms;
+
+/* Short names of the character classes used in the char_class table below */
+#define EF CC_EOF
+#define PL CC_PLUS
+#define MI CC_MINUS
+#define ST CC_STAR
+#define SL CC_SLASH
+#define GT CC_GREATER
+#define LT CC_LESS
+#define EQ CC_EQUAL
+#define EX CC_EXCL
+#define QM CC_QUESTION
+#define LP CC_L_PAR
+#define RP CC_R_PAR
+#define LB CC_L_BRAC
+#define RB CC_R_BRAC
+#define CO CC_COLON
+#define CM CC_COMMA
+#define UL CC_UNDER_L
+#define DT CC_DOT
+#define QT CC_QUOTE
+#define BS CC_BACKSLASH
+#define DG CC_DIGIT
+#define HX CC_HEX_ALPHA
+#define XP CC_EXP
+#define EC CC_ESC_CHAR
+#define EU CC_ESC_U
+#define AL CC_ALPHA
+#define BL CC_BLANK
+#define TB CC_TAB
+#define SC CC_SPACE_CTRL
+#define NL CC_EOL
+#define CT CC_CTRL
+#define OT CC_OTHER
 
-// Input file source
-FILE *file_src;
+/**
+ * @brief Character class of every byte, index 0 belongs to EOF (use CHAR_CLASS()).
+ */
+static const unsigned char char_class[257] = {
+    EF, // EOF
+    CT, CT, CT, CT, CT, CT, CT, CT, CT, TB, NL, SC, SC, SC, CT, CT,  // 0x00 - 0x0F
+    CT, CT, CT, CT, CT, CT, CT, CT, CT, CT, CT, CT, CT, CT, CT, CT,  // 0x10 - 0x1F
+    BL, EX, QT, OT, OT, OT, OT, OT, LP, RP, ST, PL, CM, MI, DT, SL,  // 0x20 - 0x2F
+    DG, DG, DG, DG, DG, DG, DG, DG, DG, DG, CO, OT, LT, EQ, GT, QM,  // 0x30 - 0x3F
+    OT, HX, HX, HX, HX, XP, HX, AL, AL, AL, AL, AL, AL, AL, AL, AL,  // 0x40 - 0x4F
+    AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, OT, BS, OT, OT, UL,  // 0x50 - 0x5F
+    OT, HX, HX, HX, HX, XP, HX, AL, AL, AL, AL, AL, AL, AL, EC, AL,  // 0x60 - 0x6F
+    AL, AL, EC, AL, EC, EU, AL, AL, AL, AL, AL, LB, OT, RB, OT, OT,  // 0x70 - 0x7F
+    OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 0x80 - 0x8F
+    OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 0x90 - 0x9F
+    OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 0xA0 - 0xAF
+    OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 0xB0 - 0xBF
+    OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 0xC0 - 0xCF
+    OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 0xD0 - 0xDF
+    OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 0xE0 - 0xEF
+    OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 0xF0 - 0xFF
+};
+
+#undef EF
+#undef PL
+#undef MI
+#undef ST
+#undef SL
+#undef GT
+#undef LT
+#undef EQ
+#undef EX
+#undef QM
+#undef LP
+#undef RP
+#undef LB
+#undef RB
+#undef CO
+#undef CM
+#undef UL
+#undef DT
+#undef QT
+#undef BS
+#undef DG
+#undef HX
+#undef XP
+#undef EC
+#undef EU
+#undef AL
+#undef BL
+#undef TB
+#undef SC
+#undef NL
+#undef CT
+#undef OT
+
+/* Character class of the character loaded from the source (EOF included) */
+#define CHAR_CLASS(c) (char_class[(c) + 1])
 
 /**
- * Sets the source file to read from.
+ * @brief Transition table of the FSM (next state for every state and character class).
+ */
+static unsigned char fsm_table[FSM_STATES_CNT][CHAR_CLASS_CNT];
+
+/**
+ * @brief Token types of the final states that don't need any further processing.
+ */
+static const Token_Type_T fsm_accept_token[FSM_STATES_CNT] = {
+    [FSM_PLUS] = TOKEN_PLUS,
+    [FSM_MINUS] = TOKEN_MINUS,
+    [FSM_ARROW] = TOKEN_ARROW,
+    [FSM_MUL] = TOKEN_MUL,
+    [FSM_DIV] = TOKEN_DIV,
+    [FSM_GREATER] = TOKEN_GREATER,
+    [FSM_GREATER_EQL] = TOKEN_GREATER_EQL,
+    [FSM_LESS] = TOKEN_LESS,
+    [FSM_LESS_EQL] = TOKEN_LESS_EQL,
+    [FSM_ASSIGN] = TOKEN_ASSIGN,
+    [FSM_EQLS] = TOKEN_EQLS,
+    [FSM_EXCL_MARK] = TOKEN_EXCL_MARK,
+    [FSM_NOT_EQLS] = TOKEN_NOT_EQLS,
+    [FSM_L_PAR] = TOKEN_L_PAR,
+    [FSM_R_PAR] = TOKEN_R_PAR,
+    [FSM_L_BRAC] = TOKEN_L_BRAC,
+    [FSM_R_BRAC] = TOKEN_R_BRAC,
+    [FSM_COLON] = TOKEN_COLON,
+    [FSM_UNDER_L] = TOKEN_UNDER_L,
+    [FSM_COMMA] = TOKEN_COMMA,
+    [FSM_NILL_CMP] = TOKEN_NILL_CMP,
+    [FSM_EOL] = TOKEN_EOL,
+    [FSM_EOF] = TOKEN_EOF,
+};
+
+/**
+ * Sets the same next state for all the character classes of the state.
  *
- * @param f Source of the input file 
+ * @param state State to be set
+ * @param next_state Next state for every character class
  */
-void set_file(FILE *f){
-    file_src = f;
+static void fsm_set_row(FSM_States_T state, FSM_States_T next_state){
+    for (int cls = 0; cls < CHAR_CLASS_CNT; cls++)
+        fsm_table[state][cls] = next_state;
 }
 
 /**
- * Creates tokens for the parser.
+ * Sets the next state for all the character classes that can be a part of an ID.
  *
- * @param token Token to be created
- * @returns The correct error return code
+ * @param state State to be set
+ * @param next_state Next state for the letters, digits and '_'
  */
-int get_token(Token_T *token){
-    int c; // Character to read from stdin
-    FSM_States_T current_state = FSM_START; // Default state
-    token->block_comm_cnt = 0; // Default nested block comments count
-
-    // Initialize a new dynamic string
-    Dynamic_Str_T dyn_str;
-    if (dynamic_str_init(&dyn_str)) // The dynamic string initialization failed
-        return COMPILER_ERR_INTER;
-
-    while(1){
-        c = getc(file_src); // Load a new character from stdin
-        switch(current_state){
-            case FSM_START: // Default state
-                if (c == '+'){
-                    current_state = FSM_PLUS;
-                } else if (c == '-'){
-                    current_state = FSM_MINUS;
-                } else if (c == '*'){
-                    current_state = FSM_MUL;
-                } else if (c == '/'){
-                    current_state = FSM_DIV;
-                } else if (c == '>'){
-                    current_state = FSM_GREATER;
-                } else if (c == '<'){
-                    current_state = FSM_LESS;
-                } else if (c == '='){
-                    current_state = FSM_ASSIGN;
-                } else if (c == '('){
-                    current_state = FSM_L_PAR;
-                } else if (c == ')'){
-                    current_state = FSM_R_PAR;
-                } else if (c == '{'){
-                    current_state = FSM_L_BRAC;
-                } else if (c == '}'){
-                    current_state = FSM_R_BRAC;
-                } else if (c == ':'){
-                    current_state = FSM_COLON;
-                } else if (c == ','){
-                    current_state = FSM_COMMA;
-                } else if (c == '?'){
-                    current_state = FSM_QUESTION_MARK;
-                } else if (c == '!'){
-                    current_state = FSM_EXCL_MARK;
-                } else if (c == '_'){ // Underline or ID
-                    append_char_to_str(&dyn_str, c);
-                    current_state = FSM_UNDER_L;
-                } else if (isalpha(c)) { // ID
-                    append_char_to_str(&dyn_str, c);
-                    current_state = FSM_ID;
-                } else if (isdigit(c)) { // Int or Float
-                    append_char_to_str(&dyn_str, c);
-                    current_state = FSM_INT;
-                } else if (c == '"'){ // String or Multiline string
-                    current_state = FSM_STRING_S;
-                } else if (c == '\n'){
-                    current_state = FSM_EOL;
-                }else if (isspace(c) || c == '\t'){ // Skip white-spaces that are not needed
-                    current_state = FSM_START;
-                } else if (c == EOF) {
-                    current_state = FSM_EOF;
-                    ungetc((char) c,file_src);
-                } else { // UNEXPECTED INPUT
-                    current_state = FSM_ERROR;
-                }
-                break;
+static void fsm_set_alnum(FSM_States_T state, FSM_States_T next_state){
+    fsm_table[state][CC_UNDER_L] = next_state;
+    fsm_table[state][CC_DIGIT] = next_state;
+    fsm_table[state][CC_HEX_ALPHA] = next_state;
+    fsm_table[state][CC_EXP] = next_state;
+    fsm_table[state][CC_ESC_CHAR] = next_state;
+    fsm_table[state][CC_ESC_U] = next_state;
+    fsm_table[state][CC_ALPHA] = next_state;
+}
 
-            case FSM_PLUS: // Final state
-                token->token_type = TOKEN_PLUS; //  +
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+/**
+ * Sets the next state for all the character classes that are a part of a string literal.
+ *
+ * @param state State to be set
+ * @param next_state Next state for all the characters above 31 except '"' and '\'
+ */
+static void fsm_set_str_content(FSM_States_T state, FSM_States_T next_state){
+    for (int cls = CC_PLUS; cls <= CC_BLANK; cls++)
+        fsm_table[state][cls] = next_state;
+    fsm_table[state][CC_OTHER] = next_state;
+    fsm_table[state][CC_QUOTE] = FSM_ERROR;     // Handled by the caller
+    fsm_table[state][CC_BACKSLASH] = FSM_ERROR; // Handled by the caller
+}
 
-            case FSM_MINUS: // Final state
-                if (c == '>') { //  ->
-                    current_state = FSM_ARROW;
-                    break;                    
-                } else { //  -
-                    token->token_type = TOKEN_MINUS;
-                    ungetc((char) c,file_src);
-                    dynamic_str_clean(&dyn_str);
-                    return NO_ERR;
-                }
+/**
+ * Fills the transition table of the FSM.
+ */
+static void fsm_table_init(){
+    // Final states accept the lexeme by default, inter states end with an error
+    for (int state = 0; state < FSM_STATES_CNT; state++)
+        fsm_set_row(state, FSM_ACCEPT);
+    fsm_set_row(FSM_START, FSM_ERROR);
+    fsm_set_row(FSM_QUESTION_MARK, FSM_ERROR);
+    fsm_set_row(FSM_FLOAT_S, FSM_ERROR);
+    fsm_set_row(FSM_EXP_S, FSM_ERROR);
+    fsm_set_row(FSM_EXP_SIGN, FSM_ERROR);
+    fsm_set_row(FSM_STRING_S, FSM_ERROR);
+    fsm_set_row(FSM_ESC_SEQ, FSM_ERROR);
+    fsm_set_row(FSM_HEXA_SEQ_S, FSM_ERROR);
+    fsm_set_row(FSM_HEXA_SEQ, FSM_ERROR);
+    fsm_set_row(FSM_HEXA_DIGIT, FSM_ERROR);
+    fsm_set_row(FSM_M_LINE_STR_S, FSM_ERROR);
+    fsm_set_row(FSM_M_LINE_STR_Q1, FSM_ERROR);
+    fsm_set_row(FSM_M_LINE_STR_Q2, FSM_ERROR);
+
+    // Default state
+    fsm_table[FSM_START][CC_PLUS] = FSM_PLUS;
+    fsm_table[FSM_START][CC_MINUS] = FSM_MINUS;
+    fsm_table[FSM_START][CC_STAR] = FSM_MUL;
+    fsm_table[FSM_START][CC_SLASH] = FSM_DIV;
+    fsm_table[FSM_START][CC_GREATER] = FSM_GREATER;
+    fsm_table[FSM_START][CC_LESS] = FSM_LESS;
+    fsm_table[FSM_START][CC_EQUAL] = FSM_ASSIGN;
+    fsm_table[FSM_START][CC_L_PAR] = FSM_L_PAR;
+    fsm_table[FSM_START][CC_R_PAR] = FSM_R_PAR;
+    fsm_table[FSM_START][CC_L_BRAC] = FSM_L_BRAC;
+    fsm_table[FSM_START][CC_R_BRAC] = FSM_R_BRAC;
+    fsm_table[FSM_START][CC_COLON] = FSM_COLON;
+    fsm_table[FSM_START][CC_COMMA] = FSM_COMMA;
+    fsm_table[FSM_START][CC_QUESTION] = FSM_QUESTION_MARK;
+    fsm_table[FSM_START][CC_EXCL] = FSM_EXCL_MARK;
+    fsm_set_alnum(FSM_START, FSM_ID);
+    fsm_table[FSM_START][CC_UNDER_L] = FSM_UNDER_L;
+    fsm_table[FSM_START][CC_DIGIT] = FSM_INT;
+    fsm_table[FSM_START][CC_QUOTE] = FSM_STRING_S;
+    fsm_table[FSM_START][CC_EOL] = FSM_EOL;
+    fsm_table[FSM_START][CC_BLANK] = FSM_START;       // Skip white-spaces that are not needed
+    fsm_table[FSM_START][CC_TAB] = FSM_START;
+    fsm_table[FSM_START][CC_SPACE_CTRL] = FSM_START;
+    fsm_table[FSM_START][CC_EOF] = FSM_EOF;
+
+    // Operators
+    fsm_table[FSM_MINUS][CC_GREATER] = FSM_ARROW;
+    fsm_table[FSM_GREATER][CC_EQUAL] = FSM_GREATER_EQL;
+    fsm_table[FSM_LESS][CC_EQUAL] = FSM_LESS_EQL;
+    fsm_table[FSM_ASSIGN][CC_EQUAL] = FSM_EQLS;
+    fsm_table[FSM_EXCL_MARK][CC_EQUAL] = FSM_NOT_EQLS;
+    fsm_table[FSM_QUESTION_MARK][CC_QUESTION] = FSM_NILL_CMP;
+
+    // Comments
+    fsm_table[FSM_DIV][CC_SLASH] = FSM_LINE_COMM_S;
+    fsm_table[FSM_DIV][CC_STAR] = FSM_BLOCK_COMM_S;
+    fsm_set_row(FSM_LINE_COMM_S, FSM_LINE_COMM_S);
+    fsm_table[FSM_LINE_COMM_S][CC_EOL] = FSM_LINE_COMMENT;
+    fsm_table[FSM_LINE_COMM_S][CC_EOF] = FSM_LINE_COMMENT;
+    fsm_set_row(FSM_BLOCK_COMM_S, FSM_BLOCK_COMM_S);
+    fsm_table[FSM_BLOCK_COMM_S][CC_STAR] = FSM_BLOCK_COMM_CL;
+    fsm_table[FSM_BLOCK_COMM_S][CC_SLASH] = FSM_NESTED_COMM;
+    fsm_table[FSM_BLOCK_COMM_S][CC_EOF] = FSM_ERROR;  // Unexpected end of file
+    fsm_set_row(FSM_NESTED_COMM, FSM_BLOCK_COMM_S);   // The character after '/' is skipped, '*' opens a nested comment
+    fsm_table[FSM_NESTED_COMM][CC_EOF] = FSM_ERROR;
+    fsm_set_row(FSM_BLOCK_COMM_CL, FSM_BLOCK_COMM_CL);
+    fsm_table[FSM_BLOCK_COMM_CL][CC_SLASH] = FSM_BLOCK_COMMENT;
+    fsm_table[FSM_BLOCK_COMM_CL][CC_EOF] = FSM_ERROR;
+
+    // IDs
+    fsm_set_alnum(FSM_UNDER_L, FSM_ID);
+    fsm_set_alnum(FSM_ID, FSM_ID);
+
+    // Numbers
+    fsm_table[FSM_INT][CC_DIGIT] = FSM_INT;
+    fsm_table[FSM_INT][CC_DOT] = FSM_FLOAT_S;
+    fsm_table[FSM_INT][CC_EXP] = FSM_EXP_S;
+    fsm_table[FSM_FLOAT_S][CC_DIGIT] = FSM_FLOAT;
+    fsm_table[FSM_FLOAT][CC_DIGIT] = FSM_FLOAT;
+    fsm_table[FSM_FLOAT][CC_EXP] = FSM_EXP_S;
+    fsm_table[FSM_EXP_S][CC_DIGIT] = FSM_EXP;
+    fsm_table[FSM_EXP_S][CC_PLUS] = FSM_EXP_SIGN;
+    fsm_table[FSM_EXP_S][CC_MINUS] = FSM_EXP_SIGN;
+    fsm_table[FSM_EXP_SIGN][CC_DIGIT] = FSM_EXP;
+    fsm_table[FSM_EXP][CC_DIGIT] = FSM_EXP;
+
+    // Strings
+    fsm_set_str_content(FSM_STRING_S, FSM_STRING_S);
+    fsm_table[FSM_STRING_S][CC_QUOTE] = FSM_STRING;
+    fsm_table[FSM_STRING_S][CC_BACKSLASH] = FSM_ESC_SEQ;
+    fsm_table[FSM_STRING][CC_QUOTE] = FSM_M_LINE_STR_S; // Only after an empty string ("""), checked in get_token()
+
+    // Escape sequences
+    fsm_table[FSM_ESC_SEQ][CC_QUOTE] = FSM_STRING_S;
+    fsm_table[FSM_ESC_SEQ][CC_BACKSLASH] = FSM_STRING_S;
+    fsm_table[FSM_ESC_SEQ][CC_ESC_CHAR] = FSM_STRING_S;
+    fsm_table[FSM_ESC_SEQ][CC_ESC_U] = FSM_HEXA_SEQ_S;
+    fsm_table[FSM_HEXA_SEQ_S][CC_L_BRAC] = FSM_HEXA_SEQ;
+    fsm_table[FSM_HEXA_SEQ][CC_R_BRAC] = FSM_STRING_S;
+    fsm_table[FSM_HEXA_SEQ][CC_DIGIT] = FSM_HEXA_DIGIT;
+    fsm_table[FSM_HEXA_SEQ][CC_HEX_ALPHA] = FSM_HEXA_DIGIT;
+    fsm_table[FSM_HEXA_SEQ][CC_EXP] = FSM_HEXA_DIGIT;
+    fsm_table[FSM_HEXA_DIGIT][CC_R_BRAC] = FSM_STRING_S;
+    fsm_table[FSM_HEXA_DIGIT][CC_DIGIT] = FSM_HEXA_SEQ;
+    fsm_table[FSM_HEXA_DIGIT][CC_HEX_ALPHA] = FSM_HEXA_SEQ;
+    fsm_table[FSM_HEXA_DIGIT][CC_EXP] = FSM_HEXA_SEQ;
+
+    // Multiline strings
+    fsm_set_str_content(FSM_M_LINE_STR_S, FSM_M_LINE_STR_S);
+    fsm_table[FSM_M_LINE_STR_S][CC_EOL] = FSM_M_LINE_STR_S;
+    fsm_table[FSM_M_LINE_STR_S][CC_TAB] = FSM_M_LINE_STR_S;
+    fsm_table[FSM_M_LINE_STR_S][CC_QUOTE] = FSM_M_LINE_STR_Q1;
+    fsm_table[FSM_M_LINE_STR_S][CC_BACKSLASH] = FSM_ESC_SEQ;
+    fsm_table[FSM_M_LINE_STR_Q1][CC_QUOTE] = FSM_M_LINE_STR_Q2;
+    fsm_table[FSM_M_LINE_STR_Q2][CC_QUOTE] = FSM_M_LINE_STR;
+}
 
-            case FSM_ARROW: // Final state
-                token->token_type = TOKEN_ARROW; //  ->
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+/**
+ * Returns the character the escape sequence stands for.
+ *
+ * @param c Character after the '\'
+ * @returns The escaped character
+ */
+static char escaped_char(int c){
+    switch (c){
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        default: return (char) c; // '"' and '\'
+    }
+}
 
-            case FSM_MUL: // Final state
-                token->token_type = TOKEN_MUL; //  *
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+/**
+ * Builds the tables shared by all the scanners (only the first time it's called).
+ */
+static void scanner_tables_init(){
+    static bool fsm_ready = false;
+    if (!fsm_ready){ // The transition table is built only once
+        fsm_table_init();
+        scan_simd_init();
+        atom_table_init(&atoms);
+        fsm_ready = true;
+    }
+}
 
-            case FSM_DIV: // Final state
-                if (c == '/'){ //  //
-                    current_state = FSM_LINE_COMM_S;
-                } else if (c == '*'){ //  /*
-                    current_state = FSM_BLOCK_COMM_S;
-                } else { //  /
-                    token->token_type = TOKEN_DIV;
-                    ungetc((char) c,file_src);
-                    dynamic_str_clean(&dyn_str);
-                    return NO_ERR;
-                }
-                break;
+/**
+ * Sets the source file to read from.
+ *
+ * @param f Source of the input file 
+ */
+void set_file(FILE *f){
+    scanner_tables_init();
+    input_buf_close(&scanner.source); // Release the previous source (if any)
+    input_buf_open(&scanner.source, f);
+    str_pool_clean(&scanner.strs); // The strings of the previous source are not needed anymore
+    scanner.atoms = &atoms;
+    scanner.suspended = false;
+}
 
-            case FSM_BLOCK_COMM_S: // Inter state
-                if (c == '*'){ //  /**
-                    current_state = FSM_BLOCK_COMM_CL;
-                } else if (c == '/' && getc(file_src) == '*'){ // Nested block comments
-                    token->block_comm_cnt++;
-                    current_state = FSM_BLOCK_COMM_S;
-                } else if (c == EOF){ // Unexpected end of file
-                    current_state = FSM_ERROR;
-                    ungetc((char) c,file_src);
-                }
-                break;
+/**
+ * Checks if any of the 8 bytes of the word equals the given byte.
+ *
+ * @param word 8 loaded bytes
+ * @param c Searched byte
+ * @returns true if the byte is in the word, false otherwise
+ */
+static inline bool word_has_byte(unsigned long long word, unsigned char c){
+    word ^= 0x0101010101010101ULL * c; // The searched bytes become zeros
+    return ((word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL) != 0;
+}
 
-            case FSM_BLOCK_COMM_CL: // Inter state
-                if (c == '/'){ //  /**/
-                    current_state = FSM_BLOCK_COMMENT;
-                } else if (c == EOF){ // Unexpected end of file
-                    current_state = FSM_ERROR;
-                    ungetc((char) c,file_src);
-                }
-                break;
+/**
+ * Writes a Unicode code point in UTF-8.
+ *
+ * @param dst Memory for the (at most 4) bytes
+ * @param code_point Unicode scalar value (up to 0x10FFFF, not a surrogate)
+ * @returns Number of the written bytes
+ */
+static size_t utf8_encode(char *dst, unsigned long code_point){
+    if (code_point < 0x80){
+        dst[0] = (char) code_point;
+        return 1;
+    }
+    if (code_point < 0x800){
+        dst[0] = (char) (0xC0 | (code_point >> 6));
+        dst[1] = (char) (0x80 | (code_point & 0x3F));
+        return 2;
+    }
+    if (code_point < 0x10000){
+        dst[0] = (char) (0xE0 | (code_point >> 12));
+        dst[1] = (char) (0x80 | ((code_point >> 6) & 0x3F));
+        dst[2] = (char) (0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    dst[0] = (char) (0xF0 | (code_point >> 18));
+    dst[1] = (char) (0x80 | ((code_point >> 12) & 0x3F));
+    dst[2] = (char) (0x80 | ((code_point >> 6) & 0x3F));
+    dst[3] = (char) (0x80 | (code_point & 0x3F));
+    return 4;
+}
 
-            case FSM_BLOCK_COMMENT: // Final state
-                if (token->block_comm_cnt == 0){
-                    current_state = FSM_START; // Ignore everything in the block comment
-                    ungetc((char) c,file_src);
-                    break;
-                } else { // We're still nested in the block comment
-                    current_state = FSM_BLOCK_COMM_S;
-                    token->block_comm_cnt--;
-                    ungetc((char) c,file_src);
-                }
+/**
+ * Decodes the escape sequences (and tabulators of multiline strings) of a string literal.
+ * \u{...} holds one code point (1 to 8 hexadecimal digits), it's written in UTF-8.
+ *
+ * @param sc Scanner
+ * @param dst Memory for the decoded string (escape sequences never get longer)
+ * @param start Offset of the first character of the string in the source
+ * @param end Offset after the last character of the string in the source
+ * @param len Length of the decoded string
+ * @returns true if the string was decoded, false for a \u{...} that is not a Unicode scalar value
+ *          (too many digits, above 0x10FFFF, a surrogate or 0, which would end the string)
+ */
+static bool decode_string(Scanner_T *sc, char *dst, size_t start, size_t end, size_t *len){
+    const unsigned char *data = sc->source.data;
+    char *str = dst;
+    size_t i = start;
+    while (i < end){
+        while (end - i >= 8){ // Characters are copied by whole words until a '\\' or '\t' shows up
+            unsigned long long word;
+            memcpy(&word, data + i, 8);
+            if (word_has_byte(word, '\\') || word_has_byte(word, '\t'))
                 break;
+            memcpy(dst, &word, 8);
+            dst += 8;
+            i += 8;
+        }
+        while (i < end && data[i] != '\\' && data[i] != '\t') // The rest of the characters one by one
+            *dst++ = data[i++];
+        if (i == end)
+            break;
+
+        int c = data[i++];
+        if (c == '\\'){ // Escape sequence (already checked by the FSM)
+            c = data[i++];
+            if (c != 'u'){
+                *dst++ = escaped_char(c);
+                continue;
+            }
+            size_t digits_start = ++i; // Skip the '{'
+            unsigned long code_point = 0;
+            while (data[i] != '}'){
+                if (i - digits_start == 8) // Too many digits
+                    return false;
+                code_point = 16 * code_point + hex_to_dec(data[i++]);
+            }
+            if (i++ == digits_start) // \u{} stands for no character
+                continue;
+            if (code_point == 0 || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF))
+                return false;
+            dst += utf8_encode(dst, code_point);
+        } else { // Tabulator in a multiline string
+            *dst++ = '8';
+        }
+    }
+    *len = dst - str;
+    return true;
+}
 
-            case FSM_LINE_COMM_S: // Inter state
-                if (c == '\n' || c == EOF){ // The end of the line comment
-                    current_state = FSM_LINE_COMMENT;
-                }
-                break;
+/**
+ * Checks if the character has to be written as an escape sequence in IFJcode23.
+ *
+ * @param c Character of a string
+ * @returns true for the whitespace, control characters, '#' and '\\', false otherwise
+ */
+static inline bool ifjcode_escaped(unsigned char c){
+    return c <= 32 || c == '#' || c == '\\';
+}
 
-            case FSM_LINE_COMMENT: // Final state
-                current_state = FSM_START; // Ignore everything in the line comment
-                ungetc((char) c,file_src);
-                break;
+/**
+ * Makes the IFJcode23 form of a string (the characters that have to be escaped are written as \0xy).
+ *
+ * @param sc Scanner
+ * @param lit Literal to store the IFJcode23 form in
+ * @param str String (it ends at the first '\0' like everywhere else in the compiler)
+ * @param len Length of the string
+ * @returns true if the form was made, false if the allocation failed
+ */
+static bool encode_string(Scanner_T *sc, Str_Lit_T *lit, const char *str, size_t len){
+    const unsigned char *src = (const unsigned char *) str;
+    size_t ifj_len = 0;
+    size_t n = 0;
+    for (; n < len && src[n] != '\0'; n++) // Every escape sequence takes 3 more characters
+        ifj_len += ifjcode_escaped(src[n]) ? 4 : 1;
+
+    char *dst = str_pool_alloc(&sc->strs, ifj_len + 1);
+    if (dst == NULL) // Allocation failed
+        return false;
+    lit->ifj_str = dst;
+    lit->ifj_len = ifj_len;
+
+    if (ifj_len == n){ // Nothing to escape
+        memcpy(dst, str, n);
+        dst[n] = '\0';
+        return true;
+    }
+    for (size_t i = 0; i < n; i++){
+        unsigned char c = src[i];
+        if (ifjcode_escaped(c)){ // \0xy, where xy is the decimal code of the character
+            *dst++ = '\\';
+            *dst++ = '0';
+            *dst++ = (char) ('0' + c / 10);
+            *dst++ = (char) ('0' + c % 10);
+        } else {
+            *dst++ = (char) c;
+        }
+    }
+    *dst = '\0';
+    return true;
+}
 
-            case FSM_GREATER: // Final state
-                if (c == '=') { //  >=
-                    current_state = FSM_GREATER_EQL;
-                    break;
-                } else { //  >
-                    token->token_type = TOKEN_GREATER;
-                    ungetc((char) c,file_src);
-                    dynamic_str_clean(&dyn_str);
-                    return NO_ERR;
-                }
-                
-            case FSM_GREATER_EQL:  // Final state
-                token->token_type = TOKEN_GREATER_EQL; //  >=
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+/**
+ * Saves the value of a string literal (together with its IFJcode23 form, see Str_Lit_T).
+ *
+ * @param sc Scanner
+ * @param token Token of the string literal
+ * @param start Offset of the first character of the string in the source
+ * @param end Offset after the last character of the string in the source
+ * @param escaped Indicates if the string has to be decoded or not
+ * @returns The correct error return code
+ */
+static int save_string(Scanner_T *sc, Token_T *token, size_t start, size_t end, bool escaped){
+    if (!scan_utf8_valid(sc->source.data + start, end - start)) // The string literal has to be valid UTF-8
+        return LEX_ERR;
 
-            case FSM_LESS: // Final state
-                if (c == '=') { //  <=
-                    current_state = FSM_LESS_EQL;
-                    break;
-                } else { //  <
-                    token->token_type = TOKEN_LESS;
-                    ungetc((char) c,file_src);
-                    dynamic_str_clean(&dyn_str);
-                    return NO_ERR;
-                }
+    char *mem = str_pool_alloc(&sc->strs, sizeof(Str_Lit_T) + end - start + 1);
+    if (mem == NULL) // Allocation failed
+        return COMPILER_ERR_INTER;
+    char *str = mem + sizeof(Str_Lit_T);
+    size_t len;
+    if (escaped){ // Only the strings with escape sequences are decoded
+        if (!decode_string(sc, str, start, end, &len))
+            return LEX_ERR;
+    } else {
+        len = end - start;
+        memcpy(str, sc->source.data + start, len);
+    }
+    str[len] = '\0';
 
-            case FSM_LESS_EQL:  // Final state
-                token->token_type = TOKEN_LESS_EQL; //  <=
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+    Str_Lit_T lit;
+    if (!encode_string(sc, &lit, str, len))
+        return COMPILER_ERR_INTER;
+    memcpy(mem, &lit, sizeof(Str_Lit_T)); // The strings in the pool are not aligned
+    token->token_value.str = str;
+    return NO_ERR;
+}
 
-            case FSM_ASSIGN: // Final state
-                if (c == '=') { //  ==
-                    current_state = FSM_EQLS;
-                    break;
-                } else { //  =
-                    token->token_type = TOKEN_ASSIGN;
-                    ungetc((char) c,file_src);
-                    dynamic_str_clean(&dyn_str);
-                    return NO_ERR;
+/**
+ * Creates the token from the lexeme accepted in the final state.
+ *
+ * @param sc Scanner
+ * @param token Token to be created (with the lexeme set)
+ * @param state Final state of the FSM
+ * @param c First character that is not a part of the lexeme (already returned to the source)
+ * @param escaped Indicates if the string literal has to be decoded or not
+ * @returns The correct error return code
+ */
+static int accept_token(Scanner_T *sc, Token_T *token, FSM_States_T state, int c, bool escaped){
+    Lexeme_T *lexeme = &token->lexeme;
+    const char *raw = (const char *) sc->source.data + lexeme->offset;
+    int kw_check;
+    switch (state){
+        case FSM_ID:
+            if ((kw_check = keyword_classify(raw, lexeme->len)) != -1){ // ID is a keyword
+                token->token_type = TOKEN_KEYWORD;
+                token->token_value.token_keyword = kw_check; // Set the correct keyword
+                if (c == '?'){ // Data type can be nil
+                    input_getc(&sc->source);
+                    lexeme->len++;
+                    token->can_be_nil = true;
                 }
-
-            case FSM_EQLS: // Final state
-                token->token_type = TOKEN_EQLS; //  ==
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
                 return NO_ERR;
+            }
+            // ID is NOT a keyword
+            token->token_type = (c == '(') ? TOKEN_FUNC_ID : TOKEN_VAR_ID;
+            if (sc->atoms != NULL) // Save the ID
+                token->token_value.str = atom_intern(sc->atoms, raw, lexeme->len);
+            else
+                token->token_value.str = str_pool_add(&sc->strs, raw, lexeme->len);
+            return (token->token_value.str == NULL) ? COMPILER_ERR_INTER : NO_ERR;
+
+        case FSM_INT:
+            token->token_type = TOKEN_INT;
+            token->token_value.num_integer = (int) num_to_uint(raw, lexeme->len); // Save the integer value
+            return NO_ERR;
+
+        case FSM_FLOAT:
+        case FSM_EXP:
+            token->token_type = TOKEN_FLOAT;
+            token->token_value.num_decimal = num_to_double(raw, lexeme->len); // Save the float value
+            return NO_ERR;
+
+        case FSM_STRING:
+            token->token_type = TOKEN_STR;
+            if (lexeme->len > 2 && raw[1] == '"') // Multiline string that ended as a string after an escape sequence
+                return save_string(sc, token, lexeme->offset + 3, lexeme->offset + lexeme->len - 1, escaped);
+            return save_string(sc, token, lexeme->offset + 1, lexeme->offset + lexeme->len - 1, escaped);
+
+        case FSM_M_LINE_STR:
+            token->token_type = TOKEN_M_LINE_STR;
+            return save_string(sc, token, lexeme->offset + 3, lexeme->offset + lexeme->len - 3, escaped);
+
+        default: // Operators, EOL
+            token->token_type = fsm_accept_token[state];
+            return NO_ERR;
+    }
+}
 
-            case FSM_L_PAR: // Final state
-                token->token_type = TOKEN_L_PAR; //  (
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+/**
+ * Skips the run of bytes that can't change the current state of the FSM.
+ *
+ * @param sc Scanner
+ * @param kind Kind of the span to be skipped
+ * @returns Number of the skipped bytes
+ */
+static inline size_t skip_span(Scanner_T *sc, Scan_Span_T kind){
+    size_t n = scan_span[kind](sc->source.data + sc->source.pos, sc->source.len - sc->source.pos);
+    sc->source.pos += n;
+    return n;
+}
 
-            case FSM_R_PAR: // Final state
-                token->token_type = TOKEN_R_PAR; //  )
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+/**
+ * Skips the hexadecimal digits of a \\u{...} escape sequence.
+ *
+ * @param sc Scanner
+ * @returns Number of the skipped digits
+ */
+static inline size_t skip_hex_digits(Scanner_T *sc){
+    size_t start = sc->source.pos;
+    while (sc->source.pos < sc->source.len){
+        Char_Class_T cc = CHAR_CLASS(sc->source.data[sc->source.pos]);
+        if (cc != CC_DIGIT && cc != CC_HEX_ALPHA && cc != CC_EXP)
+            break;
+        sc->source.pos++;
+    }
+    return sc->source.pos - start;
+}
 
-            case FSM_L_BRAC: // Final state
-                token->token_type = TOKEN_L_BRAC; //  {
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+/**
+ * Creates the next token from the source of the scanner.
+ *
+ * @param sc Scanner
+ * @param token Token to be created
+ * @returns The correct error return code
+ */
+int scanner_get_token(Scanner_T *sc, Token_T *token){
+    int c; // Character to read from the source
+    size_t start = sc->source.pos; // Offset of the first character of the lexeme
+    bool str_empty = true; // Indicates if the string literal has no characters (yet)
+    bool escaped = false;  // Indicates if the string literal has to be decoded or not
+    FSM_States_T current_state = FSM_START; // Default state
+    FSM_States_T next_state;
+    token->block_comm_cnt = 0; // Default nested block comments count
+    token->symbol = NULL; // The parser resolves the IDs
+
+    if (sc->suspended){ // Continue with the unfinished lexeme
+        start = sc->start;
+        str_empty = sc->str_empty;
+        escaped = sc->escaped;
+        current_state = sc->state;
+        token->block_comm_cnt = sc->block_comm_cnt;
+        sc->suspended = false;
+    }
 
-            case FSM_R_BRAC: // Final state
-                token->token_type = TOKEN_R_BRAC; //  }
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+    while(1){
+        if (current_state == FSM_START) // The lexeme starts with the next character
+            start = sc->source.pos;
+        c = input_getc(&sc->source); // Load a new character from the source
+        if (c == EOF && sc->source.awaiting){ // The rest of the input wasn't fed yet
+            sc->suspended = true;
+            sc->start = start;
+            sc->str_empty = str_empty;
+            sc->escaped = escaped;
+            sc->state = current_state;
+            sc->block_comm_cnt = token->block_comm_cnt;
+            return SCANNER_NEED_INPUT;
+        }
+        next_state = fsm_table[current_state][CHAR_CLASS(c)];
 
-            case FSM_COLON: // Final state
-                token->token_type = TOKEN_COLON; //  :
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+        // Actions performed on the transition
+        switch (next_state){
+            case FSM_ACCEPT: // The lexeme was loaded
+                input_unget(&sc->source, c);
+                token->lexeme.offset = start;
+                token->lexeme.len = sc->source.pos - start;
+                return accept_token(sc, token, current_state, c, escaped);
 
-            case FSM_UNDER_L: // Final state
-                if (isalpha(c) || isdigit(c) || c == '_'){ //  ID
-                    append_char_to_str(&dyn_str, c);
-                    current_state = FSM_ID;
-                    break;
-                } else { //  _
-                    token->token_type = TOKEN_UNDER_L;
-                    ungetc((char) c,file_src);
-                    dynamic_str_clean(&dyn_str);
-                    return NO_ERR;
-                }
+            case FSM_ERROR: // UNEXPECTED INPUT
+                return LEX_ERR;
 
-            case FSM_COMMA: // Final state
-                token->token_type = TOKEN_COMMA; //  ,
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
+            case FSM_EOF:
+                if (sc->source.failed) // The input couldn't be loaded
+                    return COMPILER_ERR_INTER;
+                token->token_type = TOKEN_EOF; //  EOF
+                token->lexeme.offset = start;
+                token->lexeme.len = 0;
                 return NO_ERR;
 
-            case FSM_QUESTION_MARK: // Final state
-                if (c == '?'){ //  ??
-                    current_state = FSM_NILL_CMP;
-                } else { //  ?
-                    current_state = FSM_ERROR;
-                    ungetc((char) c,file_src);
-                }
+            case FSM_START:
+                skip_span(sc, SCAN_SPAN_BLANK); // Skip white-spaces that are not needed
                 break;
 
-            case FSM_NILL_CMP: // Final state
-                token->token_type = TOKEN_NILL_CMP; //  ??
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
-
-            case FSM_EXCL_MARK: // Final state
-                if (c == '='){ //  !=
-                    current_state = FSM_NOT_EQLS;
-                    break;
-                } else { //  !
-                    token->token_type = TOKEN_EXCL_MARK;
-                    ungetc((char) c,file_src);
-                    dynamic_str_clean(&dyn_str);
-                    return NO_ERR;
-                }
+            case FSM_ID:
+                skip_span(sc, SCAN_SPAN_ID); // The rest of the ID at once
+                break;
 
-            case FSM_NOT_EQLS: // Final state
-                token->token_type = TOKEN_NOT_EQLS; //  !=
-                ungetc((char) c,file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+            case FSM_ESC_SEQ:
+                escaped = true;
+                break;
 
-            case FSM_ID: // Final state
-                if (isalpha(c) || isdigit(c) || c == '_'){ // Loading the ID
-                    append_char_to_str(&dyn_str, c);
-                    break;
-                } else if (c == '?') { // Possible nil data type
-                    int kw_check;
-                    if ((kw_check = keyword_cmpr(dyn_str.dynamic_str)) != -1){ // Variable ID is a keyword
-                        token->token_type = TOKEN_KEYWORD; // Final state
-                        token->token_value.token_keyword = kw_check; // Set the correct keyword value
-                        token->can_be_nil = true; // Data type can be nil
-                        dynamic_str_clean(&dyn_str);
-                        return NO_ERR;
-                    } else { // Variable ID is NOT a keyword
-                        ungetc((char) c,file_src);
-                        token->token_type = TOKEN_VAR_ID;
-                        token->token_value.dyn_str = dyn_str; // Save the dynamic string
-                        return NO_ERR;
-                    }
-                } else if (c == '('){ // Function ID or a keyword
-                    ungetc((char) c,file_src);
-                    int kw_check;
-                    if ((kw_check = keyword_cmpr(dyn_str.dynamic_str)) != -1){ // ID is a keyword
-                        token->token_type = TOKEN_KEYWORD; // Final state
-                        token->token_value.token_keyword = kw_check; // Set the correct keyword
-                        dynamic_str_clean(&dyn_str);
-                        return NO_ERR;
-                    } else {  // ID is NOT a keyword
-                        token->token_type = TOKEN_FUNC_ID;
-                        token->token_value.dyn_str = dyn_str; // Save the dynamic string
-                        return NO_ERR;
-                    }
-                } else { // Variable ID or a keyword
-                    ungetc((char) c,file_src);
-                    int kw_check;
-                    if ((kw_check = keyword_cmpr(dyn_str.dynamic_str)) != -1){ // Variable ID is a keyword
-                        token->token_type = TOKEN_KEYWORD; // Final state
-                        token->token_value.token_keyword = kw_check; // Set the correct keyword
-                        dynamic_str_clean(&dyn_str);
-                        return NO_ERR;
-                    } else { // Variable ID is NOT a keyword
-                        token->token_type = TOKEN_VAR_ID;
-                        token->token_value.dyn_str = dyn_str; // Save the dynamic string
-                        return NO_ERR; 
-                    }       
-                }
+            case FSM_STRING_S:
+                if (current_state != FSM_START && current_state != FSM_HEXA_SEQ) // \u{} is the only empty sequence
+                    str_empty = false;
+                if (skip_span(sc, SCAN_SPAN_STRING) != 0) // Everything up to the next '"', '\\' or a control character
+                    str_empty = false;
+                break;
 
-            case FSM_INT: // Final state
-                if (isdigit(c)){ // Loading the integer
-                    append_char_to_str(&dyn_str, c);
-                } else if (c == '.') { // Loading the float
-                    append_char_to_str(&dyn_str, c);
-                    current_state = FSM_FLOAT_S;
-                } else if (c == 'e' || c == 'E'){ // Loading the exponent
-                    token->negative_exp = false; // The exponent is positive (+) by default
-                    append_char_to_str(&dyn_str, c);
-                    current_state = FSM_EXP_S;
-                } else { // The integer was loaded
-                    ungetc((char) c,file_src);
-                    unsigned long int int_value = strtoul(dyn_str.dynamic_str, NULL, 10); // Convert the string to an integer
-                    token->token_type = TOKEN_INT;
-                    token->token_value.num_integer = (int) int_value; // Save the integer value
-                    dynamic_str_clean(&dyn_str);
-                    return NO_ERR;
+            case FSM_HEXA_SEQ:
+                if (current_state == FSM_HEXA_DIGIT){ // Hexadecimal number has 2 digits
+                    str_empty = false;
+                } else { // Right after the '{', all the hexadecimal digits are skipped at once
+                    size_t digits = skip_hex_digits(sc);
+                    if (digits != 0)
+                        str_empty = false;
+                    if (digits % 2 == 1) // The last hexadecimal number has only 1 digit (so far)
+                        next_state = FSM_HEXA_DIGIT;
                 }
                 break;
-            
-                case FSM_FLOAT_S: // Inter state
-                    if (isdigit(c)){ // Loading the float
-                        append_char_to_str(&dyn_str, c);
-                        current_state = FSM_FLOAT;
-                    } else { 
-                        current_state = FSM_ERROR;
-                        ungetc((char) c,file_src);
-                    }
-                    break;
-
-                case FSM_FLOAT: // Final state
-                    if (isdigit(c)){ // Loading the float
-                        append_char_to_str(&dyn_str, c);
-                    } else if (c == 'e' || c == 'E') { // Loading the exponent
-                        token->negative_exp = false; // The exponent is positive (+) by default
-                        append_char_to_str(&dyn_str, c);
-                        current_state = FSM_EXP_S;
-                    } else { // The float was loaded
-                        ungetc((char) c, file_src);
-                        double double_value = strtod(dyn_str.dynamic_str, NULL); // Convert the string to a double
-                        token->token_type = TOKEN_FLOAT;
-                        token->token_value.num_decimal = (double) double_value; // Save the float value
-                        dynamic_str_clean(&dyn_str);
-                        return NO_ERR;
-                    }
-                    break;
-
-                case FSM_EXP_S: // Inter state
-                    if (isdigit(c)){ // Loading the exponent
-                        append_char_to_str(&dyn_str, c);
-                        current_state = FSM_EXP;
-                    } else if (c == '+' || c == '-') { // Loading the exponent sign
-                        if (c == '-') // The exponent is negative (-)
-                            token->negative_exp = true;
-
-                        current_state = FSM_EXP_SIGN;
-                    } else {
-                        current_state = FSM_ERROR;
-                        ungetc((char) c,file_src);
-                    }
-                    break;
-
-                case FSM_EXP_SIGN: // Inter state
-                    if (isdigit(c)){ // Loading the exponent
-                        append_char_to_str(&dyn_str, c);
-                        current_state = FSM_EXP;
-                    } else {
-                        current_state = FSM_ERROR;
-                        ungetc((char) c,file_src);
-                    }
-                    break;
-
-                case FSM_EXP: // Final state
-                    if (isdigit(c)){ // Loading the exponent
-                        append_char_to_str(&dyn_str, c);
-                    } else { // The exponent was loaded
-
-                        // Exponent conversion logic
-                        double value;
-                        Dynamic_Str_T base;
-                        Dynamic_Str_T exp;
-                        dynamic_str_init(&base); // Tmp var to load the base number
-                        dynamic_str_init(&exp);  // Tmp var to load the exponent number
-
-                        bool e = false;
-                        for (unsigned i = 0; i < (dyn_str.str_len); i++)
-                        {
-                            if (dyn_str.dynamic_str[i] == 'e' || dyn_str.dynamic_str[i] == 'E'){
-                                e = true;
-                                i++;
-                            }
-                            if (e == false){ // Loading the float part
-                                append_char_to_str(&base,dyn_str.dynamic_str[i]);
-
-                            } else if (e == true){ // Loading the exponent part
-                                append_char_to_str(&exp,dyn_str.dynamic_str[i]);
-                            }  
-                        }
-                        value = atof(base.dynamic_str); // Convert the string to a float
-                        int i = 0;
-                        while (i < atoi(exp.dynamic_str)){
-                            if (token->negative_exp == true) // The exponent is negative (-)
-                                value = value * 0.1;
-                            else // The exponent is positive (+)
-                                value = value * 10;
-                            i++;
-                        }
-                        // The exponent was converted correctly
-                        ungetc((char) c, file_src);
-                        token->token_type = TOKEN_FLOAT;
-                        token->token_value.num_decimal = value;
-                        dynamic_str_clean(&dyn_str);
-                        return NO_ERR;
-                    }
-                    break;
-                
-            case FSM_STRING_S: // Inter state
-                if (c > 31 && c != 34 && c != 92) { // The symbol is not a '"" or a '\'
-                    append_char_to_str(&dyn_str, c);
-                } else if (c == 34){ // The string was loaded
-                    current_state = FSM_STRING;
-                } else if (c == 92){ // Loading the escape sequence
-                    current_state = FSM_ESC_SEQ;
-                } else {
-                    current_state = FSM_ERROR;
-                    ungetc((char) c,file_src);
+
+            case FSM_M_LINE_STR_S:
+                if (current_state == FSM_STRING && !str_empty){ // '"' right after a string, the string was loaded
+                    input_unget(&sc->source, c);
+                    token->lexeme.offset = start;
+                    token->lexeme.len = sc->source.pos - start;
+                    return accept_token(sc, token, current_state, c, escaped);
                 }
+                if (c == '\t') // Tabulators are stored as '8'
+                    escaped = true;
+                skip_span(sc, SCAN_SPAN_STRING); // Everything up to the next '"', '\\' or a control character
                 break;
 
-            case FSM_ESC_SEQ: // Inter state
-                    if (c == 34){
-                        append_char_to_str(&dyn_str, '\"');
-                        current_state = FSM_STRING_S;
-                    } else if (c == 92) {
-                        append_char_to_str(&dyn_str, '\\');
-                        current_state = FSM_STRING_S;
-                    } else if (c == 'n') {
-                        append_char_to_str(&dyn_str, '\n');
-                        current_state = FSM_STRING_S;
-                    } else if (c == 't') {
-                        append_char_to_str(&dyn_str, '\t');
-                        current_state = FSM_STRING_S;
-                    } else if (c == 'r') {
-                        append_char_to_str(&dyn_str, '\r');
-                        current_state = FSM_STRING_S;
-                    } else if (c == 'u'){
-                        current_state = FSM_HEXA_SEQ_S; // Hexadecimal escape sequence
-                    } else {
-                        current_state = FSM_ERROR;
-                        ungetc((char) c,file_src);
-                    }
-                    break;
-
-            case FSM_HEXA_SEQ_S: // Inter state
-                if (c == '{'){ //  \u{
-                    current_state = FSM_HEXA_SEQ;
-                } else {
-                    current_state = FSM_ERROR;
-                    ungetc((char) c,file_src);
-                }
+            case FSM_BLOCK_COMM_S:
+                if (current_state == FSM_NESTED_COMM && c == '*') // Nested block comments
+                    token->block_comm_cnt++;
+                skip_span(sc, SCAN_SPAN_COMMENT); // Skip everything up to the next '*' or '/'
                 break;
 
-            case FSM_HEXA_SEQ:
-                if (c == '}'){ //  \u{}
-                    current_state = FSM_STRING_S;
-                    break;
-                }
+            case FSM_BLOCK_COMM_CL:
+                skip_span(sc, SCAN_SPAN_COMMENT);
+                break;
 
-                if (isdigit(c) || (c >= 65 && c <= 70) || (c >= 95 && c <= 102)){
-                    // Loading the next char to check if the hexadecimal number has 2 digits
-                    char tmp = getc(file_src);
-                    // The value of a hexadecimal number 
-                    char value;
-                    // Hexadecimal number has 2 digits
-                    if(isdigit(tmp) || (tmp >= 65 && tmp <= 70) || (tmp >= 95 && tmp <= 102)){
-                        value = 16*hex_to_dec(c) + hex_to_dec(tmp); // Convert to decimal value
-                        append_char_to_str(&dyn_str,value);
-                        current_state = FSM_HEXA_SEQ;
-                    } else if (tmp == '}'){ // The hexadecimal number has only 1 digit
-                        value = hex_to_dec(c);
-                        append_char_to_str(&dyn_str,value);
-                        current_state = FSM_STRING_S;
-                    } else {
-                        current_state = FSM_ERROR;
-                        ungetc((char) c,file_src);
-                    }
-                } else {
-                    current_state = FSM_ERROR;
-                    ungetc((char) c,file_src);
-                }
+            case FSM_LINE_COMM_S:
+                skip_span(sc, SCAN_SPAN_EOL); // Skip everything up to the end of the line
                 break;
-            
-            case FSM_STRING: // Final state
-                if (c == 34 && dyn_str.str_len == 0) { //  """   
-                    current_state = FSM_M_LINE_STR_S;
-                } else { // The string was loaded
-                    ungetc((char) c, file_src);
-                    token->token_type = TOKEN_STR;
-                    token->token_value.dyn_str = dyn_str; // Save the dynamic string
-                    return NO_ERR;
+
+            case FSM_BLOCK_COMMENT:
+                if (token->block_comm_cnt == 0){
+                    next_state = FSM_START; // Ignore everything in the block comment
+                } else { // We're still nested in the block comment
+                    next_state = FSM_BLOCK_COMM_S;
+                    token->block_comm_cnt--;
                 }
                 break;
 
-            case FSM_M_LINE_STR_S: // Inter state
-                if (c > 31 && c != 34 && c != 92) { // The symbol is not a '"" or a '\'
-                    append_char_to_str(&dyn_str, c);
-                } else if (c == 34){ // Indicates the end of a multiline string
-                    current_state = FSM_M_LINE_STR;
-                } else if (c == 92){ // Loading the escape sequence
-                    current_state = FSM_ESC_SEQ;
-                } else if (c == '\n') {
-                    append_char_to_str(&dyn_str, c);
-                } else if (c == '\t'){
-                    append_char_to_str(&dyn_str, '8');
-                } else {
-                    current_state = FSM_ERROR;
-                    ungetc((char) c,file_src);
-                }
+            case FSM_LINE_COMMENT:
+                next_state = FSM_START; // Ignore everything in the line comment
                 break;
-            
-            case FSM_M_LINE_STR: //Final state
-                if (c == 34 && (getc(file_src)) == 34){ //  """"""
-                    token->token_type = TOKEN_M_LINE_STR;
-                    token->token_value.dyn_str = dyn_str; // Save the dynamic string
-                    return NO_ERR;
-                } else {
-                    current_state = FSM_ERROR;
-                    ungetc((char) c,file_src);    
-                }    
+
+            default:
                 break;
+        }
+        current_state = next_state;
+    }
+}
 
-            case FSM_EOL: // Final state
-                token->token_type = TOKEN_EOL; //  \n
-                ungetc((char) c, file_src);
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;     
+/**
+ * Sets up a scanner the input is fed to by scanner_feed() (instead of reading a file).
+ * scanner_get_token() returns SCANNER_NEED_INPUT whenever the fed input ends in the middle
+ * of a token, the scanning continues where it stopped once more input is fed.
+ *
+ * @param sc Scanner to be set up
+ */
+void scanner_open(Scanner_T *sc){
+    scanner_tables_init();
+    input_buf_open_push(&sc->source);
+    str_pool_init(&sc->strs);
+    sc->atoms = &atoms;
+    sc->suspended = false;
+}
 
-            case FSM_EOF: // Final state
-                token->token_type = TOKEN_EOF; //  EOF
-                dynamic_str_clean(&dyn_str);
-                return NO_ERR;
+/**
+ * Feeds the next chunk of the input to the scanner.
+ *
+ * @param sc Scanner set up by scanner_open()
+ * @param buf Next chunk of the input
+ * @param len Length of the chunk
+ * @returns The correct error return code
+ */
+int scanner_feed(Scanner_T *sc, const char *buf, size_t len){
+    return (input_buf_push(&sc->source, buf, len) == INPUT_BUF_OK) ? NO_ERR : COMPILER_ERR_INTER;
+}
 
-            case FSM_ERROR: // Error state
-                dynamic_str_clean(&dyn_str);
-                return LEX_ERR;
-        }
-    }
+/**
+ * Tells the scanner no more input will be fed (the rest of the tokens and the EOF can be scanned).
+ *
+ * @param sc Scanner set up by scanner_open()
+ */
+void scanner_finish(Scanner_T *sc){
+    sc->source.awaiting = false;
+}
+
+/**
+ * Frees the input and the strings held by the scanner.
+ *
+ * @param sc Scanner set up by scanner_open()
+ */
+void scanner_close(Scanner_T *sc){
+    input_buf_close(&sc->source);
+    str_pool_clean(&sc->strs);
+    sc->suspended = false;
+}
+
+/**
+ * Creates tokens for the parser.
+ *
+ * @param token Token to be created
+ * @returns The correct error return code
+ */
+int get_token(Token_T *token){
+    return scanner_get_token(&scanner, token);
 }
-/* End of scanner.c */
\ No newline at end of file
+/* End of scanner.c */
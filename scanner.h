@@ -11,8 +11,12 @@
 #include "utils.h"    
 #include "error.h"        
 #include "dynamic_str.h"  
-#include <stdio.h>        // FILE, fopen(), getc(), ...
+#include "input_buf.h"    
+#include "str_pool.h"
+#include "atom_table.h"
+#include <stdio.h>        // FILE, fopen(), ...
 #include <stdbool.h> 
+#include <string.h>       // memcpy()
 
 /*
  * / ****************** Token_Type_T ******************* \  
@@ -60,11 +64,31 @@ typedef enum Token_Type{
 */
 typedef struct Token_Value{
     Keywords_T token_keyword; // Keyword value
-    Dynamic_Str_T dyn_str;    // String value
+    char *str;                // String value (IDs and string literals, owned by the scanner)
     int num_integer;          // Integer value
     double num_decimal;       // Double value
 } Token_Value_T;
 
+/*
+ * / ********************** Lexeme_T ********************** \  
+ * / Structure that holds the position of a token in the source \
+*/
+typedef struct Lexeme{
+    size_t offset;     // Offset of the first character in the input buffer
+    unsigned int len;  // Number of characters of the token
+} Lexeme_T;
+
+/*
+ * / *************************** Str_Lit_T **************************** \
+ * / Structure stored in the pool right before every string literal     \
+ * / It holds the IFJcode23 form of the literal, which is made only once \
+ * / by the scanner, so the code generator never has to escape anything \
+*/
+typedef struct Str_Lit{
+    const char *ifj_str;  // IFJcode23 form of the literal ('\0' terminated)
+    size_t ifj_len;       // Length of the IFJcode23 form
+} Str_Lit_T;
+
 /*
  * / *********************** Token_T *********************** \  
  * / Structure that contains all the information about token \
@@ -72,11 +96,40 @@ typedef struct Token_Value{
 typedef struct Token{
     Token_Type_T token_type;    // Type of a token
     Token_Value_T token_value;  // Value of a token
+    Lexeme_T lexeme;            // Characters of a token in the source
     bool can_be_nil;            // Indicates if a data type can be nil or not
     int block_comm_cnt;         // Counter for nested block comments
-    bool negative_exp;          // Indicates if the float exponent is negative (-) or not (+)
+    struct Tnode *symbol;       // Symbol the ID is resolved to by the parser (NULL ~ not resolved yet)
+    bool global_symbol;         // Indicates if the symbol is in the global scope or not
 } Token_T;
 
+/*
+ * / ********************** Scanner_T ********************** \
+ * / Structure that holds everything one scanner works with \
+*/
+typedef struct Scanner{
+    Input_Buf_T source;   // Input loaded into the memory
+    Str_Pool_T strs;      // Strings of the string literals (valid until the source changes)
+    Atom_Table_T *atoms;  // Table the IDs are interned in (NULL ~ the IDs are copied to strs)
+
+    /* Unfinished lexeme (the pushed input ran out in the middle of it) */
+    bool suspended;       // Indicates if the scanning stopped in the middle of a lexeme or not
+    FSM_States_T state;   // State the scanning stopped in
+    size_t start;         // Offset of the first character of the lexeme
+    bool str_empty;       // Indicates if the string literal has no characters (yet)
+    bool escaped;         // Indicates if the string literal has to be decoded or not
+    int block_comm_cnt;   // Nested block comments count
+} Scanner_T;
+
+/* Scanner of the source set by set_file() */
+extern Scanner_T scanner;
+
+/* Atoms of all the identifiers (the IDs of the tokens are atoms, see atom_table.h) */
+extern Atom_Table_T atoms;
+
+/* Return value of scanner_get_token() if the pushed input ends in the middle of a token */
+#define SCANNER_NEED_INPUT (-1)
+
 /*
  * / ****************** set_file() ******************* \  
  * / Function that sets up the input file to read from \
@@ -89,5 +142,47 @@ void set_file(FILE *f);
 */
 int get_token(Token_T *token);
 
+/*
+ * / ****************** scanner_get_token() ****************** \
+ * / Function that creates a new token from the given scanner \
+*/
+int scanner_get_token(Scanner_T *sc, Token_T *token);
+
+/*
+ * / ****************** scanner_open() ****************** \
+ * / Function that sets up a scanner the input is fed to  \
+*/
+void scanner_open(Scanner_T *sc);
+
+/*
+ * / ******************** scanner_feed() ******************** \
+ * / Function that feeds the next chunk of the input to the scanner \
+*/
+int scanner_feed(Scanner_T *sc, const char *buf, size_t len);
+
+/*
+ * / ******************* scanner_finish() ******************* \
+ * / Function that tells the scanner no more input will be fed \
+*/
+void scanner_finish(Scanner_T *sc);
+
+/*
+ * / ***************** scanner_close() ****************** \
+ * / Function that frees everything held by the scanner   \
+*/
+void scanner_close(Scanner_T *sc);
+
+/*
+ * / *********************** str_lit_ifjcode() ************************ \
+ * / Function that returns the IFJcode23 form of a string literal value \
+ * / (only the values of the TOKEN_STR and TOKEN_M_LINE_STR tokens)     \
+*/
+static inline const char *str_lit_ifjcode(const char *str, size_t *len){
+    Str_Lit_T lit;
+    memcpy(&lit, str - sizeof(Str_Lit_T), sizeof(Str_Lit_T)); // The strings in the pool are not aligned
+    *len = lit.ifj_len;
+    return lit.ifj_str;
+}
+
 #endif
 /* End of scanner.h */
\ No newline at end of file
@@ -0,0 +1,96 @@
+/* ******************************** str_pool.c ******************************* */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Store the strings of the tokens without allocating each one */
+/* *************************************************************************** */
+
+#include "str_pool.h"   // header file
+#include <stdlib.h>     // malloc(), free()
+#include <string.h>     // memcpy()
+
+/**
+ * Initializes a new (empty) pool.
+ *
+ * @param pool Pool to be initialized
+ */
+void str_pool_init(Str_Pool_T *pool){
+    pool->head = NULL;
+}
+
+/**
+ * Reserves n bytes for a string in the pool.
+ *
+ * @param pool Pool to allocate from
+ * @param n Number of bytes to reserve
+ * @returns Pointer to the reserved bytes, NULL if the allocation failed
+ */
+char *str_pool_alloc(Str_Pool_T *pool, size_t n){
+    Str_Pool_Block_T *block = pool->head;
+    if (block == NULL || block->size - block->used < n){ // The current block is full
+        size_t size = (n > STR_POOL_BLOCK) ? n : STR_POOL_BLOCK;
+        block = (Str_Pool_Block_T *) malloc(sizeof(Str_Pool_Block_T) + size);
+        if (block == NULL) // Malloc failed
+            return NULL;
+        block->next = pool->head;
+        block->used = 0;
+        block->size = size;
+        pool->head = block;
+    }
+    char *mem = block->data + block->used;
+    block->used += n;
+    return mem;
+}
+
+/**
+ * Stores a '\0' terminated copy of n characters.
+ *
+ * @param pool Pool to store the string in
+ * @param mem Characters to be copied
+ * @param n Number of the characters
+ * @returns Pointer to the stored string, NULL if the allocation failed
+ */
+char *str_pool_add(Str_Pool_T *pool, const char *mem, size_t n){
+    char *str = str_pool_alloc(pool, n + 1);
+    if (str == NULL) // Allocation failed
+        return NULL;
+    memcpy(str, mem, n);
+    str[n] = '\0';
+    return str;
+}
+
+/**
+ * Moves all the strings of another pool into the pool (the strings stay where they are).
+ *
+ * @param pool Pool to move the strings to
+ * @param src Pool to move the strings from (empty afterwards)
+ */
+void str_pool_merge(Str_Pool_T *pool, Str_Pool_T *src){
+    if (src->head == NULL) // Nothing to move
+        return;
+    if (pool->head == NULL){
+        pool->head = src->head;
+    } else { // The blocks are linked behind the block that is being filled
+        Str_Pool_Block_T *tail = src->head;
+        while (tail->next != NULL)
+            tail = tail->next;
+        tail->next = pool->head->next;
+        pool->head->next = src->head;
+    }
+    src->head = NULL;
+}
+
+/**
+ * Frees all the strings stored in the pool.
+ *
+ * @param pool Pool to be cleaned
+ */
+void str_pool_clean(Str_Pool_T *pool){
+    Str_Pool_Block_T *block = pool->head;
+    while (block != NULL){
+        Str_Pool_Block_T *next = block->next;
+        free(block);
+        block = next;
+    }
+    pool->head = NULL;
+}
+/* End of str_pool.c */
@@ -0,0 +1,67 @@
+/* ******************************** str_pool.h ******************************* */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Header file for str_pool.c                                  */
+/* *************************************************************************** */
+
+#ifndef STR_POOL_H
+#define STR_POOL_H
+
+#include <stddef.h>   // size_t
+
+/* Default size of one block of the pool in bytes */
+#define STR_POOL_BLOCK 65536
+
+/*
+ * / ********************* Str_Pool_Block_T ********************* \
+ * / Structure that holds one block of the strings stored in a pool \
+*/
+typedef struct Str_Pool_Block {
+    struct Str_Pool_Block *next;   // Previously filled block
+    size_t used;                   // Number of used bytes
+    size_t size;                   // Number of allocated bytes
+    char data[];                   // Stored strings
+} Str_Pool_Block_T;
+
+/*
+ * / ************************** Str_Pool_T *************************** \
+ * / Structure that stores many short strings in a few big blocks       \
+ * / The strings are never moved, so the pointers stay valid until the  \
+ * / whole pool is cleaned                                              \
+*/
+typedef struct Str_Pool {
+    Str_Pool_Block_T *head;   // Block that is being filled
+} Str_Pool_T;
+
+/*
+ * / ************* str_pool_init() ************** \
+ * / Function that initializes a new (empty) pool \
+*/
+void str_pool_init(Str_Pool_T *pool);
+
+/*
+ * / ***************** str_pool_alloc() ****************** \
+ * / Function that reserves n bytes for a string in the pool \
+*/
+char *str_pool_alloc(Str_Pool_T *pool, size_t n);
+
+/*
+ * / ******************** str_pool_add() ******************** \
+ * / Function that stores a '\0' terminated copy of n characters \
+*/
+char *str_pool_add(Str_Pool_T *pool, const char *mem, size_t n);
+
+/*
+ * / ****************** str_pool_merge() ******************* \
+ * / Function that moves all the strings of src into the pool \
+*/
+void str_pool_merge(Str_Pool_T *pool, Str_Pool_T *src);
+
+/*
+ * / **************** str_pool_clean() ***************** \
+ * / Function that frees all the strings stored in the pool \
+*/
+void str_pool_clean(Str_Pool_T *pool);
+
+#endif
+/* End of str_pool.h */
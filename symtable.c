@@ -5,527 +5,898 @@
 /*  Functionality: Symbol table implementation using height balanced BST            */
 /* ******************************************************************************** */
 
+#define _POSIX_C_SOURCE 200809L   // posix_memalign()
+
 #include "symtable.h"
+#include "atom_table.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stddef.h>   // offsetof()
+
+// Size of the block header, rounded up so the nodes stay aligned
+#define SYMTABLE_BLOCK_HEADER ((sizeof(TNode_Block) + SYMTABLE_NODE_ALIGN - 1) / SYMTABLE_NODE_ALIGN * SYMTABLE_NODE_ALIGN)
 
 /**
- * Helper function for printig tree structure, DELETE BEFORE SUBMITTING
- * 
+ * @brief helper function that hands out a node from the blocks of the table
+ * @param tree pointer to tree structure
+ * @return pointer to the node, NULL if the allocation fails
  */
+static TNode *alloc_node(TTree *tree) {
+    // Deleted nodes are reused first
+    if (tree->free_nodes != NULL) {
+        TNode *node = tree->free_nodes;
+        memcpy(&tree->free_nodes, node, sizeof(TNode *));
+        return node;
+    }
 
-#define COUNT 6
+    TNode_Block *block = tree->blocks;
+    if (block == NULL || block->used == block->capacity) {
+        // Every block is twice as big as the previous one (up to SYMTABLE_BLOCK_MAX nodes)
+        size_t capacity = (block == NULL) ? SYMTABLE_BLOCK_MIN : block->capacity * 2;
+        if (capacity > SYMTABLE_BLOCK_MAX) {
+            capacity = SYMTABLE_BLOCK_MAX;
+        }
+        void *memory;
+        if (posix_memalign(&memory, SYMTABLE_NODE_ALIGN, SYMTABLE_BLOCK_HEADER + capacity * sizeof(TNode)) != 0) {
+            return NULL;
+        }
+        block = (TNode_Block *)memory;
+        block->nodes = (TNode *)((char *)memory + SYMTABLE_BLOCK_HEADER); // the nodes start on a cache line
+        block->next = tree->blocks;
+        block->used = 0;
+        block->capacity = capacity;
+        tree->blocks = block;
+    }
+    return &block->nodes[block->used++];
+}
 
 /**
- * @brief helper function to calculate heights of subtrees, this function will be called automatically
- * @param root 
+ * @brief helper function that stores the data of a node (only the data of its type are kept)
+ * @param node pointer to the node
+ * @param type type of the node (variable / function)
+ * @param var_data data of varible
+ * @param func_data data of function
  */
-int get_height(TNode *root){
-    if (root == NULL) {
-        return 0;
+static inline void set_data(TNode *node, enum Type type, TData_var var_data, TData_func func_data) {
+    node->type = type;
+    if (type == FUNCTION) {
+        node->data.function_data = func_data;
+    } else {
+        node->data.variable_data = var_data;
     }
+}
 
-    // Get heights of left and right subtree
-    int left_height = get_height(root->left_node);
-    int right_height = get_height(root->right_node);
+/**
+ * @brief helper function that returns the node to its table (the memory is freed with the blocks)
+ * @param tree pointer to tree structure the node belongs to
+ * @param to_delete pointer to the node that will be freed
+ */
+static void free_node(TTree *tree, TNode *to_delete) {
+    if (to_delete == NULL) {
+        return;
+    }
 
-    // Return the bigger height + 1 (for this node)
-    if (left_height > right_height) {
-        return 1 + left_height;
-    } else {
-        return 1 + right_height;
+    // The id is an atom, it's not owned by the node
+    memcpy(to_delete, &tree->free_nodes, sizeof(TNode *)); // the free nodes are linked through their first bytes
+    tree->free_nodes = to_delete;
+}
+
+/**
+ * @brief helper function that frees all the blocks of the table
+ * @param tree pointer to tree structure
+ */
+static void free_blocks(TTree *tree) {
+    while (tree->blocks != NULL) {
+        TNode_Block *next = tree->blocks->next;
+        free(tree->blocks);
+        tree->blocks = next;
     }
+    tree->free_nodes = NULL;
 }
 
 /**
- * @brief helper function for balancing tree, this function will be called automatically
- * @param critical node that has to be balanced 
+ * @brief helper function that frees all the blocks of the table but the newest (biggest) one,
+ *        which is emptied to be used again
+ * @param tree pointer to tree structure
  */
-int balance_tree_helper(TNode *critical) {
-    // check if the node is null
-    if (critical == NULL) {
-        return 0;
+static void reuse_blocks(TTree *tree) {
+    TNode_Block *newest = tree->blocks;
+    if (newest != NULL) {
+        tree->blocks = newest->next;
+        free_blocks(tree);
+        newest->next = NULL;
+        newest->used = 0;
+        tree->blocks = newest;
     }
+    tree->free_nodes = NULL;
+}
 
-    // Get height of critical node's subtrees
-    int left = get_height(critical->left_node);
-    int right = get_height(critical->right_node);
+/**
+ * @brief helper function that copies a node shared by a snapshot
+ * @param tree pointer to tree structure
+ * @param link pointer to the pointer to the shared node (it's redirected to the copy)
+ * @return pointer to the copy, NULL if the allocation fails
+ */
+static TNode *copy_node(TTree *tree, TNode **link) {
+    TNode *copy = alloc_node(tree);
+    if (copy == NULL) {
+        return NULL;
+    }
+    *copy = **link;
+    copy->version = tree->version;
+    *link = copy; // the snapshots keep the original
+    return copy;
+}
 
-    // If critical node is imbalanced on the left
-    if (left > right) {
-        // check for null pointers
-        if (critical->left_node == NULL) {
-            // error
-            return 0;  
-        }
+/**
+ * @brief helper function that makes the node behind a link writable (a node shared by a snapshot is copied)
+ *        (without snapshots this is one comparison, the copying is kept out of the insert/delete loops)
+ * @param tree pointer to tree structure
+ * @param link pointer to the pointer to the node (it's redirected to the copy)
+ * @return pointer to the writable node, NULL if the allocation fails
+ */
+static inline TNode *own_node(TTree *tree, TNode **link) {
+    TNode *node = *link;
+    return symbol_shared(tree, node) ? copy_node(tree, link) : node;
+}
 
-        left = get_height(critical->left_node->left_node);
-        right = get_height(critical->left_node->right_node);
+/**
+ * @brief helper function that returns a deleted node to the table (nodes shared by a snapshot are kept)
+ * @param tree pointer to tree structure
+ * @param node deleted node
+ */
+static inline void release_node(TTree *tree, TNode *node) {
+    if (!symbol_shared(tree, node)) {
+        free_node(tree, node);
+    }
+}
 
-        // If critical's left node is imbalanced on the left
-        // LL
-        if (left > right) {
-            return 1;
+
+
+
+/**
+ * @brief helper function
+ */
+char *my_strdup(const char *input_string) {
+    size_t len = strlen(input_string) + 1;
+    char *output_string = malloc(len);
+    if (output_string != NULL) {
+        memcpy(output_string, input_string, len);
+    }
+    return output_string;
+}
+
+#ifndef SYMTABLE_HASH
+
+/* ************************** Height balanced BST ************************** */
+
+/**
+ * @brief helper function that returns the stored height of a subtree
+ * @param root root node of the subtree
+ * @return height of the subtree, 0 for an empty one
+ */
+static inline int get_height(TNode *root){
+    return (root == NULL) ? 0 : root->height;
+}
+
+/**
+ * @brief helper function that recalculates the height of a node from its subtrees
+ * @param node node whose subtrees have the correct heights already
+ */
+static inline void update_height(TNode *node){
+    int left_height = get_height(node->left_node);
+    int right_height = get_height(node->right_node);
+    node->height = 1 + ((left_height > right_height) ? left_height : right_height);
+}
+
+/**
+ * @brief helper function that rotates the subtree to the right
+ * @param critical root of the subtree
+ * @return new root of the subtree
+ */
+static TNode *rotate_right(TNode *critical){
+    TNode *left = critical->left_node;
+    critical->left_node = left->right_node;
+    left->right_node = critical;
+    update_height(critical);
+    update_height(left);
+    return left;
+}
+
+/**
+ * @brief helper function that rotates the subtree to the left
+ * @param critical root of the subtree
+ * @return new root of the subtree
+ */
+static TNode *rotate_left(TNode *critical){
+    TNode *right = critical->right_node;
+    critical->right_node = right->left_node;
+    right->left_node = critical;
+    update_height(critical);
+    update_height(right);
+    return right;
+}
+
+/**
+ * @brief balances critical node whose subtrees are already balanced (LL, LR, RL and RR cases)
+ *        (the rotated nodes are copied first if a snapshot shares them, if that fails the node stays imbalanced)
+ * @param tree pointer to tree structure
+ * @param critical writable node that will be balanced
+ * @return new root of the subtree
+ */
+static TNode *balance_tree(TTree *tree, TNode *critical){
+    update_height(critical);
+    int balance = get_height(critical->left_node) - get_height(critical->right_node);
+
+    if (balance > 1) { // Critical node is imbalanced on the left
+        TNode *left = own_node(tree, &critical->left_node);
+        if (left == NULL) {
+            return critical;
         }
-        // If critical's left node is imbalanced on the right
-        // LR
-        else if (left < right) {
-            return 2;
+        if (get_height(left->left_node) < get_height(left->right_node)) {
+            if (own_node(tree, &left->right_node) == NULL) {
+                return critical;
+            }
+            critical->left_node = rotate_left(left); // LR
         }
+        return rotate_right(critical); // LL
     }
-    // If critical node is imbalanced on the right
-    else if (left < right) {
-        // check for null pointers
-        if (critical->right_node == NULL) {
-            // error
-            return 0;  
+    if (balance < -1) { // Critical node is imbalanced on the right
+        TNode *right = own_node(tree, &critical->right_node);
+        if (right == NULL) {
+            return critical;
         }
-
-        left = get_height(critical->right_node->left_node);
-        right = get_height(critical->right_node->right_node);
-
-        // If critical's right node is imbalanced on the left
-        // RL
-        if (left > right) {
-            return 3;
+        if (get_height(right->right_node) < get_height(right->left_node)) {
+            if (own_node(tree, &right->left_node) == NULL) {
+                return critical;
+            }
+            critical->right_node = rotate_right(right); // RL
         }
-        // If critical's right node is imbalanced on the right
-        // RR
-        else if (left < right) {
-            return 4;
+        return rotate_left(critical); // RR
+    }
+    return critical;
+}
+
+/**
+ * @brief balances the nodes on the path from the changed node up to the root
+ * @param tree pointer to tree structure
+ * @param path links (pointers to the child pointers) of the writable nodes on the path, root first
+ * @param depth number of the nodes on the path
+ */
+static void balance_path(TTree *tree, TNode **path[], int depth){
+    while (depth-- > 0) {
+        TNode **link = path[depth];
+        int old_height = (*link)->height;
+        *link = balance_tree(tree, *link);
+        if ((*link)->height == old_height) {
+            return; // Heights of the nodes above can't change anymore
         }
     }
+}
+
+/**
+ * @brief helper function that searches for node specified by id in a subtree
+ * @param root root node of the subtree
+ * @param id   specifies which node to return
+ * @return pointer to node, NULL if id is not found
+ */
+static TNode *search_tree(TNode *root, char *id){
+    // Walk down until the id is found or the subtree is empty
+    while (root != NULL && root->id != id) {
+        // If root id is bigger, search left subtree, otherwise search right subtree
+        root = (atom_cmp(id, root->id) < 0) ? root->left_node : root->right_node;
+    }
 
-    return 0;
+    return root;
 }
+
 /**
- * @brief helper function that finds the parent of a node
- * @param root root node of a tree
- * @param child node whose parent will be searched for
- * @return parent node if found, null if parent and child are root nodes
+ * / ***************** delete_symbol() *********************** \
+ *    @brief deletes node specified by id (O(log n))
+ *    @param tree pointer to the tree
+ *    @param id   specifies which node to delete
+ *    @return 1 on success, otherwise 0
  */
-TNode *find_parent(TNode *root, TNode *child){
+int delete_symbol(TTree *tree, char *id){
+    TNode **path[SYMTABLE_MAX_HEIGHT];
+    int depth = 0;
 
-    TNode *parent = root;	
+    if (search_symbol(tree, id) == NULL) {
+        return 0;
+    }
 
-    if(parent == NULL){return NULL;}
+    // find link to the node to delete (the nodes on the path are made writable)
+    TNode **link = &tree->root;
+    while ((*link)->id != id) {
+        path[depth++] = link;
+        TNode *node = own_node(tree, link);
+        if (node == NULL) {
+            return 0;
+        }
+        link = (atom_cmp(id, node->id) < 0) ? &node->left_node : &node->right_node;
+    }
+    TNode *to_delete = *link;
 
-    if(parent == child){return NULL;}
+    if (to_delete->left_node == NULL || to_delete->right_node == NULL) {
+        // at most one subtree, parent gets it
+        *link = (to_delete->left_node != NULL) ? to_delete->left_node : to_delete->right_node;
+    } else {
+        // both subtrees, node is replaced with the leftmost node of the right subtree
+        // (the nodes are relinked, so the pointers to the other nodes stay valid)
+        int to_delete_depth = depth;
+        path[depth++] = link;
 
-    while(parent->left_node != child && parent->right_node != child){
-        if(strcmp(parent->id, child->id) > 0){
-            parent = parent->left_node;
+        to_delete = own_node(tree, link); // its right subtree is going to change
+        if (to_delete == NULL) {
+            return 0;
         }
-        else if(strcmp(child->id, parent->id) > 0){
-            parent = parent->right_node;
+        TNode **replace_link = &to_delete->right_node;
+        TNode *to_replace_with;
+        while ((to_replace_with = own_node(tree, replace_link)) != NULL && to_replace_with->left_node != NULL) {
+            path[depth++] = replace_link;
+            replace_link = &to_replace_with->left_node;
+        }
+        if (to_replace_with == NULL) {
+            return 0; // only the copies were linked in, the tree is the same
+        }
+        *replace_link = to_replace_with->right_node; // if replacement node has right child, parent gets it
+
+        to_replace_with->left_node = to_delete->left_node;
+        to_replace_with->right_node = to_delete->right_node;
+        to_replace_with->height = to_delete->height;
+        *link = to_replace_with;
+        if (depth > to_delete_depth + 1) {
+            path[to_delete_depth + 1] = &to_replace_with->right_node; // the deleted node was on the path
         }
     }
 
-    return parent;
+    release_node(tree, to_delete);
+    balance_path(tree, path, depth);
+    return 1;
 }
 
+
 /**
- * @brief balances critical nodes, this function will be called automatically
- * @param critical node that will be balanaced
+ * / ***************** init_symtable() *********************** \
+ *    @brief initializes sym. table
+ *    @param pointer to tree structure
  */
-int balance_tree(TTree *tree, TNode *critical) {
-    int type = balance_tree_helper(critical);
+void init_symtable(TTree *tree){
+    tree->root = NULL;
+    tree->blocks = NULL;
+    tree->free_nodes = NULL;
+    tree->version = 0;
+}
 
-    TNode *parent;
-    TNode *ll;
-    TNode *left;
-    TNode *left_right;
-    TNode *rr;
-    TNode *right;
-    TNode *right_left;
+/**
+ * / ***************** insert_symbol() *********************** \
+ *    @brief inserts node (O(log n), only the path to the new node is balanced)
+ *    @param tree pointer to tree structure
+ *    @param id name of the variable / function
+ *    @param type type of the node (variable / function)
+ *    @param var_data data of varible
+ *    @param func_data data of function
+ *    @return 1 on success, otherwise 0
+ */
+int insert_symbol(TTree *tree, char *id, enum Type type, TData_var var_data, TData_func func_data) {
+    TNode **path[SYMTABLE_MAX_HEIGHT];
+    int depth = 0;
+
+    // find position of the node (the nodes on the path are made writable)
+    TNode **link = &tree->root;
+    while (*link != NULL) {
+        TNode *node = own_node(tree, link);
+        if (node == NULL) {
+            return 0;
+        }
+        if (node->id == id) {
+            // Duplicate identifiers -> overwrite
+            set_data(node, type, var_data, func_data);
+            return 1;
+        }
+        path[depth++] = link;
+        link = (atom_cmp(id, node->id) < 0) ? &node->left_node : &node->right_node;
+    }
 
-    switch (type) {
-        case 1: ;
-            if (critical != NULL && critical->left_node != NULL) {
-                ll = critical->left_node;
-                critical->left_node = ll->right_node;
-                ll->right_node = critical;
+    // allocate memmory for node and insert it
+    TNode *node = alloc_node(tree);
+    if (node == NULL) {
+        return 0; // Handle memory allocation error
+    }
+    // Assign data
+    node->id = id; // Atoms live as long as the atom table
+    set_data(node, type, var_data, func_data);
+    node->left_node = NULL;
+    node->right_node = NULL;
+    node->height = 1;
+    node->version = tree->version;
+    *link = node;
+
+    balance_path(tree, path, depth);
+    return 1;
+}
 
-            // update parent
-                parent = find_parent(tree->root, critical);  
-                if (parent != NULL) {
-                    if (parent->left_node == critical) {
-                        parent->left_node = ll;
-                    } else if (parent->right_node == critical) {
-                        parent->right_node = ll;
-                    }
-                } else {
-                    tree->root = ll;  // Update the root if it critical was the root
-                }
-            }
-            break;
-        case 2: ;
-            left = critical->left_node;
-            left_right = left->right_node;
-
-            left->right_node = left_right->left_node;
-            left_right->left_node = left;
-            critical->left_node = left_right->right_node;
-            left_right->right_node = critical;
-
-            // update parent
-            parent = find_parent(tree->root, critical);  
-            if (parent != NULL) {
-                if (parent->left_node == critical) {
-                    parent->left_node = left_right;
-                } else if (parent->right_node == critical) {
-                    parent->right_node = left_right;
-                }
-            } else {
-                tree->root = left_right;   // Update the root if it critical was the root
-            }
-            break;
-        case 3: ;
-            // Right-Left (RL) imbalance
-            
-            right = critical->right_node;
-            right_left = right->left_node;
-
-            right->left_node = right_left->right_node;
-            right_left->right_node = right;
-            critical->right_node = right_left->left_node;
-            right_left->left_node = critical;
-
-            // update parent
-            parent = find_parent(tree->root, critical);  
-            if (parent != NULL) {
-                if (parent->left_node == critical) {
-                    parent->left_node = right_left;
-                } else if (parent->right_node == critical) {
-                    parent->right_node = right_left;
-                }
-            } else {
-                tree->root = right_left;  // Update the root if it critical was the root
-            }
-            
-            break;
-        case 4: ;
-            // Right-Right (RR) imbalance
-            
-            rr = critical->right_node;
-            critical->right_node = rr->left_node;
-            rr->left_node = critical;
-            
-            // update parent
-            parent = find_parent(tree->root, critical);
-            if (parent != NULL) {
-                if (parent->left_node == critical) {
-                    parent->left_node = rr;
-                } else if (parent->right_node == critical) {
-                    parent->right_node = rr;
-                }
-            } else {
-                tree->root = rr;    // Update the root if it critical was the root
-            }
+/**
+ * / ***************** search_symbol() *********************** \
+ *    @brief searches for node specified by id
+ *    @param tree pointer to tree structure
+ *    @param id   specifies which node to return
+ *    @return pointer to node, NULL if id is not found
+ */
+TNode *search_symbol(TTree *tree, char *id) {
+    if (id == NULL || id[0] == '\0') {
+        // Invalid id, return NULL to indicate failure.
+        
+        return NULL;
+    }
 
-            break;
-        case 0: ;
-            return 0;
-            break;
+    return search_tree(tree->root, id);
+}
+
+/**
+ * / ***************** edit_symbol() *********************** \
+ *    @brief searches for node specified by id that is going to be modified
+ *           (shared nodes on the path to it are copied, the nodes above a writable node are writable already)
+ *    @param tree pointer to tree structure
+ *    @param id   specifies which node to return
+ *    @return pointer to node, NULL if id is not found (or the copying fails)
+ */
+TNode *edit_symbol(TTree *tree, char *id) {
+    TNode *node = search_symbol(tree, id);
+    if (node == NULL || !symbol_shared(tree, node)) {
+        return node;
     }
+
+    TNode **link = &tree->root;
+    while ((node = own_node(tree, link)) != NULL && node->id != id) {
+        link = (atom_cmp(id, node->id) < 0) ? &node->left_node : &node->right_node;
+    }
+    return node;
+}
+
+/**
+ * / ***************** snapshot_symtable() *********************** \
+ *    @brief takes a snapshot of the tree in O(1) (the tree is shared until it's modified)
+ *    @param tree pointer to tree structure
+ *    @param snapshot snapshot to be set up
+ *    @return 1 on success, otherwise 0
+ */
+int snapshot_symtable(TTree *tree, TSnapshot *snapshot) {
+    if (tree->version == SYMTABLE_MAX_VERSION) {
+        return 0;
+    }
+    snapshot->root = tree->root;
+    tree->version++; // the current nodes belong to the snapshot from now on
     return 1;
 }
 
 /**
- * @brief check whether nodes are height balanced, this function will be called automatically
- * @param root specifies which subtree to check
- * @param tree will be passed to balance_tree function
- * @return 1 if subtree is balanced, 0 if balancing failed
- */
-int check_balance(TNode *root, TTree *tree){
-    if(root == NULL){return 1;}
-
-    // check subtrees
-    check_balance(root->left_node, tree);
-    check_balance(root->right_node, tree);
-    
-    // get heights
-    int l = get_height(root->left_node)+1;
-    int r = get_height(root->right_node)+1;
-    
-    // is balancing needed?
-    if(get_height(root->left_node) > get_height(root->right_node) + 1){
-        return balance_tree(tree, root);
-    }else
-    if(get_height(root->left_node) < get_height(root->right_node) - 1){
-        return balance_tree(tree, root);
-    }else{
-        return 1;
+ * / ***************** restore_symtable() *********************** \
+ *    @brief brings the tree back to the version of a snapshot in O(1)
+ *    @param tree pointer to tree structure the snapshot was taken of
+ *    @param snapshot snapshot of the tree
+ *    @return 1 on success, otherwise 0
+ */
+int restore_symtable(TTree *tree, const TSnapshot *snapshot) {
+    if (tree->version == SYMTABLE_MAX_VERSION) {
+        return 0;
     }
+    tree->root = snapshot->root;
+    tree->version++; // nodes of the replaced version might still be referenced, they must not be written
+    return 1;
+}
+
+/**
+ * / ***************** search_snapshot() *********************** \
+ *    @brief searches for node specified by id in a snapshot
+ *    @param snapshot pointer to the snapshot
+ *    @param id   specifies which node to return
+ *    @return pointer to node, NULL if id is not found
+ */
+TNode *search_snapshot(const TSnapshot *snapshot, char *id) {
+    return search_tree(snapshot->root, id);
 }
 
+/**
+ * / ***************** release_snapshot() *********************** \
+ *    @brief releases the snapshot (its nodes belong to the tree, nothing is freed)
+ *    @param snapshot pointer to the snapshot
+ */
+void release_snapshot(TSnapshot *snapshot) {
+    snapshot->root = NULL;
+}
 
 /** 
- * / ***************** free_node() ********************* \
- * @brief Frees allocated memmory
- * @param root pointer to the node that will be freed
+ * / ***************** dispose_sym_table() ********************* \
+ * @brief disposes the tree (the nodes are not visited, their blocks are freed)
+ * @param tree pointer to the tree that will be disposed
  */
-void free_node(TNode *to_delete) {
-    if (to_delete == NULL) {
-        return;
-    }
-
-    if(to_delete->id != NULL)
-        free(to_delete->id);
+void dispose_symtable(TTree *tree) {
+    free_blocks(tree);
+    init_symtable(tree);
+}
 
-    free(to_delete);
+/**
+ * / ***************** clear_symtable() ********************* \
+ * @brief removes all the nodes of the tree (the biggest block is kept for the next insertions)
+ * @param tree pointer to the tree that will be cleared
+ */
+void clear_symtable(TTree *tree) {
+    reuse_blocks(tree);
+    tree->root = NULL;
 }
 
+#else
 
+/* ************************ Robin Hood hash table ************************* */
 
+/**
+ * @brief helper function that computes the home slot of an id
+ * @param tree pointer to tree structure with allocated slots
+ * @param id atom (its address is hashed, the characters are never read)
+ * @return index of the home slot
+ */
+static inline size_t home_slot(TTree *tree, char *id){
+    return atom_addr_hash(id) & (tree->capacity - 1);
+}
+
+/**
+ * @brief helper function that computes how far a slot is from the home slot of its id
+ * @param tree pointer to tree structure
+ * @param index index of a non-empty slot
+ * @return distance from the home slot
+ */
+static inline size_t probe_distance(TTree *tree, size_t index){
+    return (index - home_slot(tree, tree->slots[index].id)) & (tree->capacity - 1);
+}
 
 /**
- * @brief delete_symbol helper function that finds suitable node
- * @param node specifies in which subtree to look
- * @return suitable node
+ * @brief helper function that finds the slot of an id
+ * @param tree pointer to tree structure
+ * @param id atom to be found
+ * @return index of the slot, capacity if id is not found
  */
-TNode *minValueNode(TNode *node)
-{
-    TNode *current = node;
- 
-    // Find leftmost node in subtree
-    while (current->left_node != NULL){
-        current = current->left_node;
+static size_t find_slot(TTree *tree, char *id){
+    if (tree->count == 0) {
+        return tree->capacity;
     }
+    size_t index = home_slot(tree, id);
+    for (size_t distance = 0; ; distance++) {
+        TSlot *slot = &tree->slots[index];
+        // Empty slot or a slot that is closer to its home than id would be ends the search
+        if (slot->id == NULL || probe_distance(tree, index) < distance) {
+            return tree->capacity;
+        }
+        if (slot->id == id) {
+            return index;
+        }
+        index = (index + 1) & (tree->capacity - 1);
+    }
+}
 
-    return current;
+/**
+ * @brief helper function that places a node into the slots (id is not in the table yet)
+ * @param tree pointer to tree structure with a free slot
+ * @param id id of the node
+ * @param node node to be placed
+ */
+static void place_node(TTree *tree, char *id, TNode *node){
+    TSlot entry = {id, node};
+    size_t index = home_slot(tree, id);
+    for (size_t distance = 0; ; distance++) {
+        TSlot *slot = &tree->slots[index];
+        if (slot->id == NULL) {
+            *slot = entry;
+            return;
+        }
+        // Robin Hood - the entry that is further from its home takes the slot
+        size_t slot_distance = probe_distance(tree, index);
+        if (slot_distance < distance) {
+            TSlot tmp = *slot;
+            *slot = entry;
+            entry = tmp;
+            distance = slot_distance;
+        }
+        index = (index + 1) & (tree->capacity - 1);
+    }
 }
 
+/**
+ * @brief helper function that allocates empty slots
+ * @param capacity number of the slots
+ * @return pointer to the slots (their reference count is 1), NULL if the allocation fails
+ */
+static TSlot *alloc_slots(size_t capacity){
+    TSlot_Array *array = (TSlot_Array *)calloc(1, sizeof(TSlot_Array) + capacity * sizeof(TSlot));
+    if (array == NULL) {
+        return NULL;
+    }
+    array->refs = 1;
+    return array->slots;
+}
 
+/**
+ * @brief helper function that returns the slot array the slots belong to
+ * @param slots slots allocated by alloc_slots()
+ * @return pointer to the slot array
+ */
+static inline TSlot_Array *slot_array(TSlot *slots){
+    return (TSlot_Array *)((char *)slots - offsetof(TSlot_Array, slots));
+}
 
+/**
+ * @brief helper function that drops one reference to the slots (they are freed with the last one)
+ * @param slots slots allocated by alloc_slots(), or NULL
+ */
+static void drop_slots(TSlot *slots){
+    if (slots != NULL && --slot_array(slots)->refs == 0) {
+        free(slot_array(slots));
+    }
+}
 
 /**
- * @brief helper function
+ * @brief helper function that makes the slots of the table writable (slots shared by a snapshot are copied)
+ * @param tree pointer to tree structure
+ * @return 1 on success, otherwise 0
  */
-char *my_strdup(const char *input_string) {
-    size_t len = strlen(input_string) + 1;
-    char *output_string = malloc(len);
-    if (output_string != NULL) {
-        memcpy(output_string, input_string, len);
+static inline int own_slots(TTree *tree){
+    if (tree->slots == NULL || slot_array(tree->slots)->refs == 1) {
+        return 1;
     }
-    return output_string;
+    TSlot *slots = alloc_slots(tree->capacity);
+    if (slots == NULL) {
+        return 0;
+    }
+    memcpy(slots, tree->slots, tree->capacity * sizeof(TSlot));
+    drop_slots(tree->slots);
+    tree->slots = slots;
+    return 1;
 }
 
-int delete_symbol(TTree *tree, char *id){
-    // get node to delete
-    TNode *to_delete = search_symbol(tree->root, id);
-    if(to_delete == NULL){return 0;}
-
-    // get its parent 
-    TNode *parent = tree->root;
-    int which_child = 0;
-
-    if(parent == to_delete){goto skip;}
-    while(parent->left_node != to_delete && parent->right_node != to_delete){
-        if(strcmp(parent->id, to_delete->id) > 0){
-            parent = parent->left_node;
-        }
-        else if(strcmp(to_delete->id, parent->id) > 0){
-            parent = parent->right_node;
-        }
+/**
+ * @brief helper function that doubles the number of slots
+ * @param tree pointer to tree structure
+ * @return 1 on success, otherwise 0
+ */
+static int grow_table(TTree *tree){
+    size_t old_capacity = tree->capacity;
+    TSlot *old_slots = tree->slots;
+    size_t capacity = (old_capacity == 0) ? SYMTABLE_HASH_SIZE : old_capacity * 2;
+    TSlot *slots = alloc_slots(capacity);
+    if (slots == NULL) {
+        return 0;
     }
-    
-    // which child is to_delete
-    if(parent->left_node == to_delete){which_child = -1;}else if(parent->right_node == to_delete){which_child = 1;}
-
-    skip:
-        /*
-            which_child = -1 -> to_delete je levy uzel 
-            which_child = 0 -> to_delete = parent (pouze v pripade, ze je to koren stromu)
-            which_child = 1 -> to_delete je pravy uzel
-        */
-        // no subtrees
-        if(to_delete->left_node == NULL & to_delete->right_node == NULL){
-            //printf("simple delete, *to_delete = null \n");
-            if(which_child == -1){free_node(to_delete);parent->left_node = NULL;return 1;}
-            if(which_child == 0){free_node(to_delete);init_symtable(tree);return 1;}
-            if(which_child == 1){free_node(to_delete);parent->right_node = NULL; return 1;}
-            return check_balance(tree->root, tree);
-        }else // only left subtree
-        if(to_delete->left_node != NULL & to_delete->right_node == NULL){
-            //printf("only left subtree -> parent gets it \n");
-            TNode *tmp = to_delete->left_node;
-            if(which_child == -1){free_node(to_delete);parent->left_node = tmp;return 1;}
-            if(which_child == 0){free_node(to_delete);tree->root = tmp;return 1;}
-            if(which_child == 1){free_node(to_delete);parent->right_node = tmp; return 1;}
-            return check_balance(tree->root, tree);
-        }else // only right subtree
-        if(to_delete->left_node == NULL & to_delete->right_node != NULL){
-            //printf("only right subtree -> parent gets it \n");
-            TNode *tmp = to_delete->right_node;
-            if(which_child == -1){free_node(to_delete);parent->left_node = tmp;return 1;}
-            if(which_child == 0){free_node(to_delete);tree->root = tmp;return 1;}
-            if(which_child == 1){free_node(to_delete);parent->right_node = tmp; return 1;}
-            return check_balance(tree->root, tree);
-        }else // both subtrees
-        if(to_delete->left_node != NULL & to_delete->right_node != NULL){
-            TNode *to_replace_with = minValueNode(to_delete->right_node);
-            //printf("both subtrees, replace node with node: %s \n", to_replace_with->id);
-            
-            // replace values
-            free(to_delete->id); // Free memory associated with the old id
-            to_delete->id = malloc(strlen(to_replace_with->id) + 1); // Allocate memory for the new id
-            strcpy(to_delete->id, to_replace_with->id);
-
-            to_delete->variable_data = to_replace_with->variable_data;
-            to_delete->function_data = to_replace_with->function_data;
-            to_delete->type = to_replace_with->type;
-            
-            // right subtree has only replacement node, delete it
-            if(to_delete->right_node == to_replace_with){
-                free_node(to_replace_with);
-                to_delete->right_node = NULL;
-                return check_balance(tree->root, tree);
-            }else // if there is more than replacement node in right subtree
-            if(to_delete->right_node != to_replace_with){
-
-                // find parent
-                TNode *replace_parent = to_delete->right_node;
-                while(replace_parent->left_node != to_replace_with)
-                {
-                    replace_parent = replace_parent->left_node;
-                }
-
-                // if replacement node has right child, parent gets is
-                if(to_replace_with->right_node != NULL){replace_parent->left_node = to_replace_with->right_node; return 1;}
-                
-                // parents left child (replacement node) will be deleted
-                replace_parent->left_node = NULL;
-                
-                free_node(to_replace_with);
-                return check_balance(tree->root, tree);
-            }
-        }
 
-    return 0;
+    tree->slots = slots;
+    tree->capacity = capacity;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_slots[i].id != NULL) {
+            place_node(tree, old_slots[i].id, old_slots[i].node);
+        }
+    }
+    drop_slots(old_slots); // a snapshot might still use them
+    return 1;
 }
 
+/**
+ * / ***************** delete_symbol() *********************** \
+ *    @brief deletes node specified by id (O(1) on average)
+ *    @param tree pointer to the tree
+ *    @param id   specifies which node to delete
+ *    @return 1 on success, otherwise 0
+ */
+int delete_symbol(TTree *tree, char *id){
+    size_t index = find_slot(tree, id);
+    if (index == tree->capacity || own_slots(tree) == 0) {
+        return 0;
+    }
+    release_node(tree, tree->slots[index].node);
+
+    // Following entries are shifted back, so no tombstones are needed
+    size_t next = (index + 1) & (tree->capacity - 1);
+    while (tree->slots[next].id != NULL && probe_distance(tree, next) > 0) {
+        tree->slots[index] = tree->slots[next];
+        index = next;
+        next = (next + 1) & (tree->capacity - 1);
+    }
+    tree->slots[index].id = NULL;
+    tree->slots[index].node = NULL;
+    tree->count--;
+    return 1;
+}
 
 /**
  * / ***************** init_symtable() *********************** \
- *    @brief initializes sym. table
+ *    @brief initializes sym. table (the slots are allocated by the first insertion)
  *    @param pointer to tree structure
  */
 void init_symtable(TTree *tree){
-    tree->root = NULL;
+    tree->slots = NULL;
+    tree->count = 0;
+    tree->capacity = 0;
+    tree->blocks = NULL;
+    tree->free_nodes = NULL;
+    tree->version = 0;
 }
 
 /**
  * / ***************** insert_symbol() *********************** \
- *    @brief inserts node   
- *    @param root pointer to pointer to root node
+ *    @brief inserts node (O(1) on average)
+ *    @param tree pointer to tree structure
  *    @param id name of the variable / function
  *    @param type type of the node (variable / function)
  *    @param var_data data of varible
  *    @param func_data data of function
  *    @return 1 on success, otherwise 0
  */
-int insert_symbol(TNode **root, char *id, enum Type type, TData_var var_data, TData_func func_data, TTree *tree) {
-    // If tree is empty, allocate memmory for node and insert it
-    if (*root == NULL) {
-        *root = (TNode *)malloc(sizeof(TNode));
-        if (*root == NULL) {
-            return 0; // Handle memory allocation error
-        }
-        // Assign data
-        (*root)->id = my_strdup(id);
-        (*root)->type = type;
-        (*root)->variable_data = var_data; 
-        (*root)->function_data = func_data; 
-        (*root)->left_node = NULL;
-        (*root)->right_node = NULL;
-        return check_balance(tree->root, tree);
-    }
-
-    // If tree is not empty, insert node at correct position
-    int cmp_result = strcmp(id, (*root)->id);
-
-    if (cmp_result < 0) {
-        return insert_symbol(&((*root)->left_node), id, type, var_data, func_data, tree);
-    } else if (cmp_result > 0) {
-        return insert_symbol(&((*root)->right_node), id, type, var_data, func_data, tree);
-    } else {
-
+int insert_symbol(TTree *tree, char *id, enum Type type, TData_var var_data, TData_func func_data) {
+    size_t index = find_slot(tree, id);
+    if (own_slots(tree) == 0) {
+        return 0;
+    }
+    if (index != tree->capacity) {
         // Duplicate identifiers -> overwrite
-        (*root)->type = type;
-        (*root)->variable_data = var_data; 
-        (*root)->function_data = func_data; 
+        TNode *node = own_node(tree, &tree->slots[index].node);
+        if (node == NULL) {
+            return 0;
+        }
+        set_data(node, type, var_data, func_data);
         return 1;
     }
 
-    return 0;
+    // Table is kept at most 3/4 full
+    if (4 * (tree->count + 1) > 3 * tree->capacity && grow_table(tree) == 0) {
+        return 0;
+    }
+
+    TNode *node = alloc_node(tree);
+    if (node == NULL) {
+        return 0; // Handle memory allocation error
+    }
+    // Assign data
+    node->id = id; // Atoms live as long as the atom table
+    set_data(node, type, var_data, func_data);
+    node->version = tree->version;
+
+    place_node(tree, id, node);
+    tree->count++;
+    return 1;
 }
 
 /**
  * / ***************** search_symbol() *********************** \
  *    @brief searches for node specified by id
- *    @param root pointer to the root node
+ *    @param tree pointer to tree structure
  *    @param id   specifies which node to return
  *    @return pointer to node, NULL if id is not found
  */
-TNode *search_symbol(TNode *root, char *id) {
+TNode *search_symbol(TTree *tree, char *id) {
     if (id == NULL || id[0] == '\0') {
         // Invalid id, return NULL to indicate failure.
         
         return NULL;
     }
 
-    // If tree is empty, return NULL
-    if (root == NULL) {
-        
+    size_t index = find_slot(tree, id);
+    return (index == tree->capacity) ? NULL : tree->slots[index].node;
+}
+
+/**
+ * / ***************** edit_symbol() *********************** \
+ *    @brief searches for node specified by id that is going to be modified (a shared node is copied)
+ *    @param tree pointer to tree structure
+ *    @param id   specifies which node to return
+ *    @return pointer to node, NULL if id is not found (or the copying fails)
+ */
+TNode *edit_symbol(TTree *tree, char *id) {
+    size_t index = find_slot(tree, id);
+    if (index == tree->capacity || (symbol_shared(tree, tree->slots[index].node) && own_slots(tree) == 0)) {
         return NULL;
     }
-    
-
-    // Compare ids
-    int cmp_result = strcmp(id, root->id);
+    return own_node(tree, &tree->slots[index].node);
+}
 
-    // If root has the id that is being searched, return the root node
-    if (cmp_result == 0) {
-        return root;
+/**
+ * / ***************** snapshot_symtable() *********************** \
+ *    @brief takes a snapshot of the table in O(1) (the slots and the nodes are shared,
+ *           the first change of the table after it copies the slots)
+ *    @param tree pointer to tree structure
+ *    @param snapshot snapshot to be set up
+ *    @return 1 on success, otherwise 0
+ */
+int snapshot_symtable(TTree *tree, TSnapshot *snapshot) {
+    if (tree->version == SYMTABLE_MAX_VERSION) {
+        return 0;
     }
-
-    // If root id is bigger, search left subtree
-    if (cmp_result < 0) {
-        return search_symbol(root->left_node, id);
+    if (tree->slots != NULL) {
+        slot_array(tree->slots)->refs++;
     }
+    snapshot->slots = tree->slots;
+    snapshot->count = tree->count;
+    snapshot->capacity = tree->capacity;
+    tree->version++; // the current nodes belong to the snapshot from now on
+    return 1;
+}
 
-    // If root id is smaller, search right subtree
-    else if (cmp_result > 0) {
-        return search_symbol(root->right_node, id);
+/**
+ * / ***************** restore_symtable() *********************** \
+ *    @brief brings the table back to the version of a snapshot in O(1) (the slots are shared with it)
+ *    @param tree pointer to tree structure the snapshot was taken of
+ *    @param snapshot snapshot of the tree
+ *    @return 1 on success, otherwise 0
+ */
+int restore_symtable(TTree *tree, const TSnapshot *snapshot) {
+    if (tree->version == SYMTABLE_MAX_VERSION) {
+        return 0;
     }
-
-    return NULL;
+    if (snapshot->slots != NULL) {
+        slot_array(snapshot->slots)->refs++;
+    }
+    drop_slots(tree->slots);
+    tree->slots = snapshot->slots;
+    tree->count = snapshot->count;
+    tree->capacity = snapshot->capacity;
+    tree->version++; // nodes of the replaced version might still be referenced, they must not be written
+    return 1;
 }
 
 /**
- * @brief dispose helper function
+ * / ***************** search_snapshot() *********************** \
+ *    @brief searches for node specified by id in a snapshot
+ *    @param snapshot pointer to the snapshot
+ *    @param id   specifies which node to return
+ *    @return pointer to node, NULL if id is not found
  */
-void dispose_helper(TNode *root){
-    if (root != NULL) {
-        // Recursively dispose of the left and right subtrees
-        dispose_helper(root->left_node);
-        dispose_helper(root->right_node);
+TNode *search_snapshot(const TSnapshot *snapshot, char *id) {
+    TTree view; // the slots of the snapshot are searched the same way as the slots of a table
+    view.slots = snapshot->slots;
+    view.count = snapshot->count;
+    view.capacity = snapshot->capacity;
+    size_t index = find_slot(&view, id);
+    return (index == view.capacity) ? NULL : view.slots[index].node;
+}
 
-        // Deallocate the node
-        free(root->id);
-        free(root);
-    }
+/**
+ * / ***************** release_snapshot() *********************** \
+ *    @brief releases the slots of the snapshot (its nodes belong to the table)
+ *    @param snapshot pointer to the snapshot
+ */
+void release_snapshot(TSnapshot *snapshot) {
+    drop_slots(snapshot->slots);
+    snapshot->slots = NULL;
+    snapshot->count = 0;
+    snapshot->capacity = 0;
 }
 
 /** 
  * / ***************** dispose_sym_table() ********************* \
- * @brief disposes the tree
+ * @brief disposes the tree (the nodes are not visited, their blocks are freed)
  * @param tree pointer to the tree that will be disposed
  */
 void dispose_symtable(TTree *tree) {
-    dispose_helper(tree->root);
+    free_blocks(tree); // the ids are atoms
+    drop_slots(tree->slots);
     init_symtable(tree);
 }
+
+/**
+ * / ***************** clear_symtable() ********************* \
+ * @brief removes all the nodes of the table (the slots and the biggest block are kept for the next insertions)
+ * @param tree pointer to the tree that will be cleared
+ */
+void clear_symtable(TTree *tree) {
+    reuse_blocks(tree);
+    if (tree->count > 0) {
+        if (slot_array(tree->slots)->refs > 1) { // a snapshot keeps the slots
+            drop_slots(tree->slots);
+            tree->slots = NULL;
+            tree->capacity = 0;
+        } else {
+            memset(tree->slots, 0, tree->capacity * sizeof(TSlot));
+        }
+        tree->count = 0;
+    }
+}
+#endif
@@ -9,6 +9,7 @@
 #define SYMTABLE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 enum Var_type {
     NIL,
@@ -29,10 +30,11 @@ enum Type {
     UNDEFINED
 };
 
+// Fields of the data are ordered by their size, so no padding is wasted
 typedef struct Tdata_var {
+    char *value;        //  Value 
     enum Var_type type;      //  Variable type - int, float, string, bool, nil
     bool init;          //  Is initialized?
-    char *value;        //  Value 
     bool constant;      //  Is constant (defined by "let")?
     bool is_param;      //  Is constant (defined by "let")?
 } TData_var;
@@ -44,27 +46,124 @@ typedef struct function_data {
 } Function_param;
 
 typedef struct Tdata_func {
-    enum Var_type ret_type;          //  Return type
     Function_param *parameters; //  Parameter count
-    bool declared;              //  Is declared?
-    bool defined;               //  Is defined?
     struct TTree *local_table;         //  Local sym. table
+    enum Var_type ret_type;          //  Return type
     int parameter_count;
+    bool declared;              //  Is declared?
+    bool defined;               //  Is defined?
 } TData_func;
 
+/*
+ * A node holds either a variable or a function (picked by its type), never both
+ * Search touches only the fields in front of the data, they share one cache line with it
+ * (a tree node takes exactly 64 bytes on 64-bit targets, the nodes are aligned to that)
+ */
+typedef union Tnode_data {
+    TData_var       variable_data;  //  Data of var. (type == VARIABLE)
+    TData_func      function_data;  //  Function data (type == FUNCTION)
+} TNode_Data;
+
 typedef struct Tnode {
-	char            *id;            //  Id
-    enum Type            type;           //  Function / variable
-    TData_var       variable_data;  //  Data of var.
-    TData_func      function_data;  //  Function data
+	char            *id;            //  Id (atom, compared by its address)
+#ifndef SYMTABLE_HASH
     struct Tnode           *left_node;     //  Left subtree
     struct Tnode           *right_node;    //  Right subtree
-} TNode;                // Node of a tree
+    unsigned int    height : 8;     //  Height of the subtree (leaf has 1)
+    unsigned int    version : 24;   //  Version of the table the node was made in
+    enum Type            type;           //  Function / variable
+#else
+    enum Type            type;           //  Function / variable
+    unsigned int    version;        //  Version of the table the node was made in
+#endif
+    TNode_Data      data;           //  Data of the variable / function
+} TNode;                // Node of a tree (or an entry of a hash table)
+
+/*
+ * Nodes of a table are not allocated one by one, they are handed out from blocks
+ * owned by the table (the nodes of one scope sit next to each other in memory)
+ * Blocks grow from SYMTABLE_BLOCK_MIN to SYMTABLE_BLOCK_MAX nodes, as most scopes hold only a few symbols
+ */
+#define SYMTABLE_BLOCK_MIN 4
+#define SYMTABLE_BLOCK_MAX 256
+
+// Alignment of the nodes of a block (size of a cache line)
+#define SYMTABLE_NODE_ALIGN 64
+
+typedef struct Tnode_block {
+    struct Tnode_block  *next;      //  Previously allocated block
+    size_t              used;       //  Number of the handed out nodes
+    size_t              capacity;   //  Number of the nodes in the block
+    TNode               *nodes;     //  Nodes of the block (they follow the block header in the same allocation)
+} TNode_Block;          // Block of nodes of a table
+
+/*
+ * The symbol table has two backends, picked at build time:
+ *   - height balanced BST (default)
+ *   - open addressing hash table with Robin Hood hashing (make SYMTABLE=hash ~ -DSYMTABLE_HASH)
+ * Both of them keep every node at the same address until it is deleted or shared by a snapshot
+ *
+ * Snapshots are read-only versions of a table that stay valid while the table changes
+ * Taking a snapshot starts a new version of the table, the nodes of the older versions are shared
+ * and never written again, the table copies them first (tree: the path to the node, O(log n))
+ * A table that was never snapshotted has version 0 and all of its nodes are writable
+ */
+#ifndef SYMTABLE_HASH
+
+// Maximum height of a tree (an AVL tree with 2^64 nodes is lower than that)
+#define SYMTABLE_MAX_HEIGHT 96
+
+// Maximum number of the versions of a table
+#define SYMTABLE_MAX_VERSION 0xFFFFFFu
 
 typedef struct Ttree {
     struct Tnode *root;
+    TNode_Block  *blocks;       //  Blocks the nodes are allocated from
+    TNode        *free_nodes;   //  Deleted nodes to be handed out again
+    unsigned int version;       //  Current version (nodes of the older ones are shared)
+} TTree;
+
+typedef struct Tsnapshot {
+    struct Tnode *root;         //  Root of the tree of the version (shared with the table)
+} TSnapshot;            // Snapshot of a tree
+
+#else
+
+// Number of the slots of a table after the first insertion (has to be a power of 2)
+#ifndef SYMTABLE_HASH_SIZE
+#define SYMTABLE_HASH_SIZE 16
+#endif
+
+typedef struct Tslot {
+    char            *id;            //  Id of the node (NULL ~ empty slot)
+    struct Tnode    *node;          //  Node stored in the slot
+} TSlot;                // Slot of a hash table
+
+typedef struct Tslot_array {
+    size_t  refs;       //  Number of the tables and snapshots using the slots (copied before a write if > 1)
+    TSlot   slots[];    //  Slots
+} TSlot_Array;          // Slots of a hash table with their reference count
+
+typedef struct Ttree {
+    TSlot  *slots;      //  Slots of the table (TSlot_Array::slots, NULL until the first insertion)
+    size_t  count;      //  Number of the stored nodes
+    size_t  capacity;   //  Number of the slots
+    TNode_Block  *blocks;       //  Blocks the nodes are allocated from
+    TNode        *free_nodes;   //  Deleted nodes to be handed out again
+    unsigned int version;       //  Current version (nodes of the older ones are shared)
 } TTree;
 
+// Maximum number of the versions of a table
+#define SYMTABLE_MAX_VERSION 0xFFFFFFFFu
+
+typedef struct Tsnapshot {
+    TSlot  *slots;      //  Slots of the version (shared with the table until one of them is modified)
+    size_t  count;      //  Number of the stored nodes
+    size_t  capacity;   //  Number of the slots
+} TSnapshot;            // Snapshot of a hash table
+
+#endif
+
 /**
  * / ***************** init_symtable() *********************** \
  *    @brief initializes sym. table
@@ -73,39 +172,101 @@ void init_symtable(TTree *tree);
 
 /**
  * / ***************** insert_symbol() *********************** \
- *    @brief recursivelly inserts new node or edits node with specified id
- *    @param root pointer to the tree root node
- *    @param id id that will be inserted or edited
+ *    @brief inserts new node or edits node with specified id
+ *    @param tree  pointer to the tree structure
+ *    @param id id that will be inserted or edited (has to be an atom)
  *    @param type type of the node (variable / function)
  *    @param var_data data of varible
  *    @param func_data data of function
- *    @param tree  pointer to the tree structure
  *    @return 1 on success, otherwise 0
  */
-int insert_symbol(TNode **root, char *id, enum Type type, TData_var var_data, TData_func func_data, TTree *tree);
+int insert_symbol(TTree *tree, char *id, enum Type type, TData_var var_data, TData_func func_data);
 
 
 /**
  * / ***************** search_symbol() *********************** \
  *    @brief searches for node specified by id
- *    @param root pointer to the tree
- *    @param id   specifies which node to return
+ *    @param tree pointer to the tree
+ *    @param id   specifies which node to return (has to be an atom)
  *    @return pointer to node, NULL if id is not found
  */
-TNode *search_symbol(TNode *root, char *id);
+TNode *search_symbol(TTree *tree, char *id);
 
 /**
  * / ***************** delete_symbol() *********************** \
  *    @brief deletes node specified by id
  *    @param root pointer to the tree
- *    @param id   specifies which node to delete
+ *    @param id   specifies which node to delete (has to be an atom)
  *    @return 1 on success, otherwise 0
  */
 int delete_symbol(TTree *root, char *id);
 
+/**
+ * / ***************** edit_symbol() *********************** \
+ *    @brief searches for node specified by id that is going to be modified
+ *           (a node shared by a snapshot is copied first, see symbol_shared())
+ *    @param tree pointer to the tree
+ *    @param id   specifies which node to return (has to be an atom)
+ *    @return pointer to node, NULL if id is not found (or the copying fails)
+ */
+TNode *edit_symbol(TTree *tree, char *id);
+
+/**
+ * / ***************** symbol_shared() *********************** \
+ *    @brief checks if a node of the table is shared by a snapshot (it must not be modified then)
+ *    @param tree pointer to the tree
+ *    @param node node of the tree
+ *    @return true if the node belongs to an older version of the table
+ */
+static inline bool symbol_shared(const TTree *tree, const TNode *node) {
+    return node->version != tree->version;
+}
+
+/**
+ * / ***************** snapshot_symtable() *********************** \
+ *    @brief takes a snapshot of the table in O(1) (hash table: the first change after it copies the slots)
+ *    @param tree pointer to the tree
+ *    @param snapshot snapshot to be set up (valid until the table is disposed)
+ *    @return 1 on success, otherwise 0
+ */
+int snapshot_symtable(TTree *tree, TSnapshot *snapshot);
+
+/**
+ * / ***************** restore_symtable() *********************** \
+ *    @brief brings the table back to the version of a snapshot (the snapshot stays valid)
+ *    @param tree pointer to the tree the snapshot was taken of
+ *    @param snapshot snapshot of the tree
+ *    @return 1 on success, otherwise 0
+ */
+int restore_symtable(TTree *tree, const TSnapshot *snapshot);
+
+/**
+ * / ***************** search_snapshot() *********************** \
+ *    @brief searches for node specified by id in a snapshot (the node must not be modified)
+ *    @param snapshot pointer to the snapshot
+ *    @param id   specifies which node to return (has to be an atom)
+ *    @return pointer to node, NULL if id is not found
+ */
+TNode *search_snapshot(const TSnapshot *snapshot, char *id);
+
+/**
+ * / ***************** release_snapshot() *********************** \
+ *    @brief frees the memory held only by the snapshot (the nodes are freed with the table)
+ *    @param snapshot pointer to the snapshot
+ */
+void release_snapshot(TSnapshot *snapshot);
+
+/**
+ * / ***************** clear_symtable() ********************* \
+ * @brief removes all the nodes of the tree, the memory is kept for the next insertions
+ *        (the snapshots are no longer valid)
+ * @param tree pointer to the tree that will be cleared
+ */
+void clear_symtable(TTree *tree);
+
 /** 
  * / ***************** dispose_sym_table() ********************* \
- * @brief disposes the tree
+ * @brief disposes the tree (all the nodes are freed at once with their blocks, the snapshots are no longer valid)
  * @param tree pointer to the tree that will be disposed
  */
 void dispose_symtable(TTree *tree);
@@ -6,6 +6,7 @@
 /* ********************************************************************************** */
 
 #include "symtable_stack.h"
+#include "atom_table.h"
 #include "error.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -16,30 +17,191 @@
  * @param st_stack Symtable stack to be initialized
  */
 void st_stack_init(Symtable_Stack_T *st_stack){
-    st_stack->stack_head = NULL;
+    st_stack->scopes = NULL;
+    st_stack->scopes_count = 0;
+    st_stack->scopes_capacity = 0;
+    st_stack->bindings = NULL;
+    st_stack->bindings_count = 0;
+    st_stack->bindings_capacity = 0;
+    st_stack->slots = NULL;
+    st_stack->slots_count = 0;
+    st_stack->slots_capacity = 0;
+}
+
+/**
+ * Finds the slot of an id in the flattened scopes.
+ *
+ * @param st_stack Symtable stack with allocated slots
+ * @param id Id of the symbol (atom)
+ * @returns The slot of the id or the empty slot the id belongs to
+ */
+static Symtable_Slot_T *find_slot(Symtable_Stack_T *st_stack, char *id){
+    size_t mask = st_stack->slots_capacity - 1;
+    size_t index = atom_addr_hash(id) & mask;
+    while (st_stack->slots[index].id != NULL && st_stack->slots[index].id != id)
+        index = (index + 1) & mask; // Linear probing (the slots are never deleted)
+    return &st_stack->slots[index];
+}
+
+/**
+ * Doubles the number of the slots of the flattened scopes.
+ *
+ * @param st_stack Symtable stack
+ * @returns The correct error return code (0 if success)
+ */
+static int grow_slots(Symtable_Stack_T *st_stack){
+    Symtable_Slot_T *old_slots = st_stack->slots;
+    size_t old_capacity = st_stack->slots_capacity;
+    size_t capacity = (old_capacity == 0) ? ST_STACK_SLOTS_SIZE : old_capacity * 2;
+    Symtable_Slot_T *slots = (Symtable_Slot_T *) calloc(capacity, sizeof(Symtable_Slot_T));
+    if (slots == NULL) // Calloc failed
+        return COMPILER_ERR_INTER;
+
+    st_stack->slots = slots;
+    st_stack->slots_capacity = capacity;
+    for (size_t i = 0; i < old_capacity; i++){ // Move the used slots to the new ones
+        if (old_slots[i].id != NULL)
+            *find_slot(st_stack, old_slots[i].id) = old_slots[i];
+    }
+    free(old_slots);
+    return NO_ERR;
+}
+
+/**
+ * Pushes a new scope record to the top of the stack (the records are only allocated
+ * when the stack is deeper than ever before, otherwise pushing is just a bump of the count).
+ *
+ * @param st_stack Symtable stack to push the scope to
+ * @returns The new scope or NULL if the memory allocation fails
+ */
+static Symtable_Scope_T *push_scope(Symtable_Stack_T *st_stack){
+    if (st_stack->scopes_count == st_stack->scopes_capacity){
+        size_t capacity = (st_stack->scopes_capacity == 0) ? ST_STACK_SCOPES_SIZE : st_stack->scopes_capacity * 2;
+        Symtable_Scope_T *scopes = (Symtable_Scope_T *) realloc(st_stack->scopes, capacity * sizeof(Symtable_Scope_T));
+        if (scopes == NULL) // Realloc failed
+            return NULL;
+        for (size_t i = st_stack->scopes_capacity; i < capacity; i++)
+            scopes[i].local_symtable = NULL; // No symtable has been created for the new levels yet
+        st_stack->scopes = scopes;
+        st_stack->scopes_capacity = capacity;
+    }
+
+    Symtable_Scope_T *scope = &st_stack->scopes[st_stack->scopes_count++];
+    scope->symtable_item = NULL;
+    scope->log_start = st_stack->bindings_count;
+    return scope;
 }
 
 /**
  * Pushes an item to the top of the symtable stack.
  *
  * @param st_stack Symtable stack to push the item to
- * @param symtable_item Symtable item to be pushed on top of the stack
+ * @param symtable_item Empty symtable item to be pushed on top of the stack (the symbols are inserted by st_stack_insert())
  * @returns The correct error return code (0 if success)
  */
 int st_stack_push(Symtable_Stack_T *st_stack, TTree *symtable_item){
-    Symtable_Stack_Item_T *tmp_item = st_stack->stack_head;
-    // Allocate memory for the new item
-    Symtable_Stack_Item_T *new_item = (Symtable_Stack_Item_T *) malloc(sizeof(Symtable_Stack_Item_T));
-    if (new_item == NULL) // Malloc failed
+    Symtable_Scope_T *scope = push_scope(st_stack);
+    if (scope == NULL) // Realloc failed
+        return COMPILER_ERR_INTER;
+    scope->symtable_item = symtable_item;
+    return NO_ERR;
+}
+
+/**
+ * Pushes a local scope to the top of the symtable stack.
+ * The symtable of the scope is owned by the stack and created by the first st_stack_insert(),
+ * so entering and leaving a block that declares nothing doesn't allocate anything.
+ *
+ * @param st_stack Symtable stack to push the scope to
+ * @returns The correct error return code (0 if success)
+ */
+int st_stack_push_scope(Symtable_Stack_T *st_stack){
+    return (push_scope(st_stack) == NULL) ? COMPILER_ERR_INTER : NO_ERR;
+}
+
+/**
+ * Inserts a symbol into the symtable on top of the stack and binds its id in the flattened scopes.
+ *
+ * @param st_stack Symtable stack to insert the symbol to
+ * @param id Id of the symbol (atom)
+ * @param type Type of the symbol (variable / function)
+ * @param var_data Data of the variable
+ * @param func_data Data of the function
+ * @returns The correct error return code (0 if success)
+ */
+int st_stack_insert(Symtable_Stack_T *st_stack, char *id, enum Type type, TData_var var_data, TData_func func_data){
+    if (st_stack->scopes_count == 0) // The symtable stack is empty
         return COMPILER_ERR_INTER;
-        
-    // Put the new item to the top of the stack and connect it to the other items
-    new_item->symtable_item = symtable_item;
-    st_stack->stack_head = new_item;
-    st_stack->stack_head->next_item = tmp_item;
+    Symtable_Scope_T *scope = &st_stack->scopes[st_stack->scopes_count - 1];
+    if (scope->symtable_item == NULL){ // First symbol of a local scope
+        if (scope->local_symtable == NULL){ // No scope on this level has needed a symtable yet
+            scope->local_symtable = (TTree *) malloc(sizeof(TTree));
+            if (scope->local_symtable == NULL) // Malloc failed
+                return COMPILER_ERR_INTER;
+            init_symtable(scope->local_symtable);
+        }
+        scope->symtable_item = scope->local_symtable;
+    }
+    TTree *symtable = scope->symtable_item;
+    if (insert_symbol(symtable, id, type, var_data, func_data) == 0) // Symbol insertion failed
+        return COMPILER_ERR_INTER;
+
+    // Allocate more memory if needed (the slots are kept at most half full)
+    if (2 * (st_stack->slots_count + 1) > st_stack->slots_capacity && grow_slots(st_stack) != NO_ERR)
+        return COMPILER_ERR_INTER;
+    if (st_stack->bindings_count == st_stack->bindings_capacity){
+        size_t capacity = (st_stack->bindings_capacity == 0) ? ST_STACK_SLOTS_SIZE : st_stack->bindings_capacity * 2;
+        Symtable_Binding_T *bindings = (Symtable_Binding_T *) realloc(st_stack->bindings, capacity * sizeof(Symtable_Binding_T));
+        if (bindings == NULL) // Realloc failed
+            return COMPILER_ERR_INTER;
+        st_stack->bindings = bindings;
+        st_stack->bindings_capacity = capacity;
+    }
+
+    Symtable_Slot_T *slot = find_slot(st_stack, id);
+    if (slot->id == NULL){ // The id has never been bound
+        slot->id = id;
+        slot->binding = 0;
+        st_stack->slots_count++;
+    } else if (slot->binding > scope->log_start){
+        return NO_ERR; // The symbol of the current scope was overwritten, it's bound already
+    }
+
+    // Bind the id to the new symbol (the outer binding is shadowed until the scope is popped)
+    Symtable_Binding_T *binding = &st_stack->bindings[st_stack->bindings_count++];
+    binding->id = id;
+    binding->node = search_symbol(symtable, id);
+    binding->symtable = symtable;
+    binding->shadowed = slot->binding;
+    slot->binding = st_stack->bindings_count;
     return NO_ERR;
 }
 
+/**
+ * Searches for a symbol through all the symtables that are on the symtable stack
+ * and tells which of the symtables it is in.
+ * Only the innermost binding of the id is looked up, so the depth of the stack doesn't matter.
+ * The found symbol is never shared by a snapshot of its symtable, so it can be modified.
+ *
+ * @param st_stack Symtable stack to be searched in
+ * @param id Id of the searched item
+ * @param symtable Symtable the item is in (set only if the item exists)
+ * @returns A pointer to the found item or NULL if the item does not exist
+ */
+TNode *search_st_stack_scope(Symtable_Stack_T *st_stack, char *id, TTree **symtable){
+    if (st_stack->slots_count == 0) // Nothing has been bound yet
+        return NULL;
+
+    Symtable_Slot_T *slot = find_slot(st_stack, id);
+    if (slot->id == NULL || slot->binding == 0) // The id is not visible in any of the scopes
+        return NULL;
+    Symtable_Binding_T *binding = &st_stack->bindings[slot->binding - 1];
+    if (binding->node != NULL && symbol_shared(binding->symtable, binding->node)) // A snapshot of the symtable was taken
+        binding->node = edit_symbol(binding->symtable, id); // The returned symbol can be modified, so it's copied
+    *symtable = binding->symtable;
+    return binding->node;
+}
+
 /**
  * Searches for a symbol through all the symtables that are on the symtable stack.
  *
@@ -48,34 +210,52 @@ int st_stack_push(Symtable_Stack_T *st_stack, TTree *symtable_item){
  * @returns A pointer to the found item or NULL if the item does not exist
  */
 TNode *search_st_stack(Symtable_Stack_T *st_stack, char *id){
-    if (st_stack->stack_head == NULL) // The symtable stack is empty
+    TTree *symtable;
+    return search_st_stack_scope(st_stack, id, &symtable);
+}
+
+/**
+ * Searches for a symbol in the scope on top of the stack only.
+ *
+ * @param st_stack Symtable stack to be searched in
+ * @param id Id of the searched item
+ * @returns A pointer to the found item or NULL if the item is not in the top scope
+ */
+TNode *search_st_stack_top(Symtable_Stack_T *st_stack, char *id){
+    if (st_stack->scopes_count == 0 || st_stack->slots_count == 0) // Nothing has been bound yet
         return NULL;
 
-    Symtable_Stack_Item_T *tmp_item = st_stack->stack_head;
-    TNode *result;
-    while (tmp_item != NULL){
-        result = search_symbol(tmp_item->symtable_item->root, id); // Search for the symbol in the current symtable
-        if (result != NULL){ // We've found a matching symbol
-            return result;
-        }
-        tmp_item = tmp_item->next_item;
+    Symtable_Slot_T *slot = find_slot(st_stack, id);
+    if (slot->id == NULL || slot->binding <= st_stack->scopes[st_stack->scopes_count - 1].log_start)
+        return NULL; // The id is not bound in the top scope
+    return search_st_stack(st_stack, id);
+}
+
+/**
+ * Undoes all the bindings made in the scope on top of the stack.
+ *
+ * @param st_stack Symtable stack with a non-empty stack
+ */
+static void unbind_scope(Symtable_Stack_T *st_stack){
+    while (st_stack->bindings_count > st_stack->scopes[st_stack->scopes_count - 1].log_start){
+        Symtable_Binding_T *binding = &st_stack->bindings[--st_stack->bindings_count];
+        find_slot(st_stack, binding->id)->binding = binding->shadowed; // The outer binding is visible again
     }
-    return NULL; // We've NOT found a matching symbol
 }
 
 /**
  * Deletes the top item from the top of the stack.
+ * The symtable of a local scope is cleared and kept for the next scope on the same level.
  *
  * @param st_stack Symtable stack to be deleted in.
  */
 void st_stack_pop(Symtable_Stack_T *st_stack){
-    if (st_stack->stack_head == NULL)
+    if (st_stack->scopes_count == 0)
         return;
-    Symtable_Stack_Item_T *tmp_item = st_stack->stack_head;
-    st_stack->stack_head = st_stack->stack_head->next_item; // Move to the next item in the symtable stack
-    // Free the correct item in the symtable stack
-    free(tmp_item);
-    tmp_item = NULL;
+    unbind_scope(st_stack);
+    Symtable_Scope_T *scope = &st_stack->scopes[--st_stack->scopes_count]; // Move to the next item in the symtable stack
+    if (scope->symtable_item != NULL && scope->symtable_item == scope->local_symtable)
+        clear_symtable(scope->local_symtable); // The symbols of the scope are not visible anymore
 }
 
 /**
@@ -84,18 +264,17 @@ void st_stack_pop(Symtable_Stack_T *st_stack){
  * @param st_stack Symtable stack to be cleaned
  */
 void st_stack_clean(Symtable_Stack_T *st_stack){
-    if (st_stack->stack_head == NULL) // The symtable stack is empty
-        return;
-
-    Symtable_Stack_Item_T *tmp_item = st_stack->stack_head->next_item;
-    while (tmp_item != NULL){
-        // Free the correct item
-        free(st_stack->stack_head);
-        st_stack->stack_head = tmp_item;
-        tmp_item = tmp_item->next_item;
+    // Free the symtables created by the stack
+    for (size_t i = 0; i < st_stack->scopes_capacity; i++){
+        if (st_stack->scopes[i].local_symtable != NULL){
+            dispose_symtable(st_stack->scopes[i].local_symtable);
+            free(st_stack->scopes[i].local_symtable);
+        }
     }
-    // Free the last item as well
-    free(st_stack->stack_head);
-    st_stack->stack_head = NULL;
+    free(st_stack->scopes);
+    // Free the flattened scopes as well
+    free(st_stack->bindings);
+    free(st_stack->slots);
+    st_stack_init(st_stack);
 }
 /* End of symtable_stack.c */
@@ -9,24 +9,63 @@
 #define ST_STACK_H
 
 #include "symtable.h"
+#include <stddef.h>   // size_t
 
 /*
- * / ************** Symtable_Stack_Item_T *************** \  
- * / Struct that holds the information about a stack item \
+ * / ***************** Symtable_Scope_T ****************** \
+ * / Struct that holds the information about a scope on the stack \
 */
-typedef struct Stack_Item {
-    struct Stack_Item *next_item;  // Item in the stack
-    TTree *symtable_item;          // Pointer to a symtable
-} Symtable_Stack_Item_T;
+typedef struct Symtable_Scope {
+    TTree *symtable_item;          // Pointer to a symtable (NULL until the first symbol of a local scope is inserted)
+    TTree *local_symtable;         // Symtable created for the local scopes on this level (reused, NULL ~ not created yet)
+    size_t log_start;              // Number of the bindings made before the symtable was pushed
+} Symtable_Scope_T;
+
+/*
+ * / ***************** Symtable_Binding_T ****************** \
+ * / Struct that binds an id to its symbol in one of the scopes \
+*/
+typedef struct Symtable_Binding {
+    char *id;         // Id of the symbol (atom)
+    TNode *node;      // Symbol in the symtable of the scope
+    TTree *symtable;  // Symtable of the scope
+    size_t shadowed;  // Binding of the same id in an outer scope (index + 1, 0 ~ none)
+} Symtable_Binding_T;
+
+/*
+ * / ****************** Symtable_Slot_T ******************* \
+ * / Struct that maps an id to its innermost visible binding \
+*/
+typedef struct Symtable_Slot {
+    char *id;         // Id of the symbol (NULL ~ empty slot)
+    size_t binding;   // Innermost binding of the id (index + 1, 0 ~ the id is not visible)
+} Symtable_Slot_T;
 
 /*
  * / ************************ Symtable_Stack_T ************************ \  
- * / Struct that holds the pointer to the top of the stack of symtables \
+ * / Struct that holds the array of the scopes (the top one is the last) \
+ * / All the scopes are also flattened into one hash table, so the      \
+ * / search takes one probe no matter how deep the nesting is (the      \
+ * / bindings made in a scope are undone when the scope is popped)      \
 */
 typedef struct Symtable_Stack {
-    Symtable_Stack_Item_T *stack_head;  // Top of the stack
+    Symtable_Scope_T *scopes;           // Scopes on the stack (the records stay allocated after a pop)
+    size_t scopes_count;                // Number of the scopes on the stack
+    size_t scopes_capacity;             // Number of the allocated scopes
+    Symtable_Binding_T *bindings;       // Bindings of all the scopes on the stack (undo log)
+    size_t bindings_count;              // Number of the bindings
+    size_t bindings_capacity;           // Number of the allocated bindings
+    Symtable_Slot_T *slots;             // Innermost bindings of all the ids ever bound
+    size_t slots_count;                 // Number of the used slots
+    size_t slots_capacity;              // Number of the allocated slots (a power of 2)
 } Symtable_Stack_T;
 
+/* Initial number of the scopes of the stack */
+#define ST_STACK_SCOPES_SIZE 16
+
+/* Initial number of the slots of the flattened scopes (has to be a power of 2) */
+#define ST_STACK_SLOTS_SIZE 64
+
 /*
  * / ************** st_stack_init *************** \
  * / Function that initializes the symtable stack \
@@ -35,16 +74,40 @@ void st_stack_init(Symtable_Stack_T *st_stack);
 
 /*
  * / ******************* st_stack_push ********************* \
- * / Function that pushes a symtable to the top of the stack \
+ * / Function that pushes an empty symtable to the top of the stack \
 */
 int st_stack_push(Symtable_Stack_T *st_stack, TTree *symtable_item);
 
+/*
+ * / ************************* st_stack_push_scope ************************** \
+ * / Function that pushes a local scope, its symtable is created only when needed \
+*/
+int st_stack_push_scope(Symtable_Stack_T *st_stack);
+
+/*
+ * / ********************** st_stack_insert ************************ \
+ * / Function that inserts a symbol into the symtable on top of the stack \
+*/
+int st_stack_insert(Symtable_Stack_T *st_stack, char *id, enum Type type, TData_var var_data, TData_func func_data);
+
 /*
  * / ************************ search_st_stack *************************** \
  * / Function that searches through all the symtables for a specific item \
 */
 TNode *search_st_stack(Symtable_Stack_T *st_stack, char *id);
 
+/*
+ * / ********************* search_st_stack_scope ********************** \
+ * / Function that searches for a specific item and the symtable it's in \
+*/
+TNode *search_st_stack_scope(Symtable_Stack_T *st_stack, char *id, TTree **symtable);
+
+/*
+ * / ********************* search_st_stack_top ********************** \
+ * / Function that searches for a specific item in the top scope only \
+*/
+TNode *search_st_stack_top(Symtable_Stack_T *st_stack, char *id);
+
 /*
  * / ******************** st_stack_pop ********************** \
  * / Function that deletes the item from the top of the stack \
@@ -0,0 +1,3 @@
+// rc: 0
+// code: WRITE string@A~
+write("\u{41}\u{7E}")
@@ -0,0 +1,3 @@
+// rc: 0
+// code: WRITE string@é߿
+write("\u{e9}\u{7FF}")
@@ -0,0 +1,3 @@
+// rc: 0
+// code: WRITE string@é
+write("\u{00e9}")
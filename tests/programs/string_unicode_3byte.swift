@@ -0,0 +1,3 @@
+// rc: 0
+// code: WRITE string@€￿
+write("\u{20AC}\u{FFFF}")
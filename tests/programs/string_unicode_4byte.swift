@@ -0,0 +1,3 @@
+// rc: 0
+// code: WRITE string@😀􏿿
+write("\u{1F600}\u{10FFFF}")
@@ -0,0 +1,2 @@
+// rc: 1
+write("\u{0}")
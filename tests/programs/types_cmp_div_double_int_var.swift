@@ -0,0 +1,4 @@
+// rc: 7
+let k = 2
+let d = 3.5
+var r = d >= d / k
@@ -0,0 +1,10 @@
+// rc: 0
+let i = 7
+let k = 2
+let d = 3.5
+var a = i / k
+var b = d / d
+var c = d / 2
+var e = 7 / d
+var f = "a" + "b"
+write(a, b, c, e, f)
@@ -0,0 +1,4 @@
+// rc: 7
+let i = 7
+let s = "ab"
+var r = 1 - i / s
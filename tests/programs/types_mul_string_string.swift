@@ -0,0 +1,3 @@
+// rc: 7
+let s = "ab"
+var r = s * s
@@ -0,0 +1,3 @@
+// rc: 7
+let n : Int? = 3
+var r = n + n
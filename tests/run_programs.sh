@@ -0,0 +1,34 @@
+#!/bin/sh
+# Compiles every tests/programs/*.swift and checks the result against the comments of the program:
+#   // rc: N        exit code of the compiler
+#   // code: LINE   line the generated code has to contain (any number of them)
+# usage: tests/run_programs.sh COMPILER
+
+compiler=$1
+out=${TMPDIR:-/tmp}/ifj2023_test_$$.code
+failed=0
+count=0
+
+for program in "$(dirname "$0")"/programs/*.swift; do
+    count=$((count + 1))
+    want=$(sed -n 's|^// rc: ||p' "$program")
+    "$compiler" < "$program" > "$out" 2>/dev/null
+    got=$?
+    if [ "$got" != "$want" ]; then
+        echo "FAIL $program: rc $got, expected $want"
+        failed=$((failed + 1))
+        continue
+    fi
+    sed -n 's|^// code: ||p' "$program" > "$out.want"
+    while IFS= read -r line; do
+        if ! grep -qxF -- "$line" "$out"; then
+            echo "FAIL $program: no line '$line' in the code"
+            failed=$((failed + 1))
+            break
+        fi
+    done < "$out.want"
+done
+
+rm -f "$out" "$out.want"
+echo "run_programs: $((count - failed)) of $count programs passed"
+[ "$failed" = 0 ]
@@ -0,0 +1,207 @@
+/* ************************** symtable_snapshot_test.c ************************* */
+/*  Subject: IFJ/IAL - Project                                                   */
+/*  Date: 17. 10. 2026                                                           */
+/*  Functionality: Check that the snapshots of a symbol table stay valid         */
+/* ***************************************************************************** */
+
+/*
+ * Random inserts, deletes and edits are applied to a table and to a plain array (the model)
+ * Snapshots are taken and restored along the way, every snapshot has to keep matching
+ * the model it was taken of while the table keeps changing (the tree is also checked to stay AVL)
+ * Built and run by make test (the backend is picked by SYMTABLE=avl / hash)
+ */
+
+#include "symtable.h"
+#include "atom_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of the distinct ids
+#define TEST_IDS 300
+
+// Maximum number of the snapshots held at once
+#define TEST_SNAPSHOTS 64
+
+// Number of the random operations
+#define TEST_STEPS 40000
+
+/*
+ * / ********* Model_T ********* \
+ * / Expected content of a table \
+*/
+typedef struct Model {
+    int value[TEST_IDS];   // Value of every id (0 ~ not in the table)
+} Model_T;
+
+static char *ids[TEST_IDS];
+static unsigned long long seed = 42;
+static int failures = 0;
+
+/**
+ * Returns the next random number (fixed LCG, every run does the same).
+ *
+ * @param n Upper bound
+ * @returns Random number from 0 to n - 1
+ */
+static int random_below(int n){
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (int) ((seed >> 33) % (unsigned long long) n);
+}
+
+/**
+ * Reports a failed check.
+ *
+ * @param step Number of the operation
+ * @param what Description of the failure
+ * @param id Index of the id
+ */
+static void fail(int step, const char *what, int id){
+    if (failures++ < 10)
+        fprintf(stderr, "step %d: %s (id %s)\n", step, what, ids[id]);
+}
+
+/**
+ * Returns the value stored in a node (0 for no node).
+ *
+ * @param node Node of a table or of a snapshot
+ * @returns Value of the node
+ */
+static int node_value(const TNode *node){
+    return (node == NULL) ? 0 : node->data.function_data.parameter_count;
+}
+
+/**
+ * Inserts an id with a value into the table.
+ *
+ * @param tree Table
+ * @param id Index of the id
+ * @param value Value to be stored
+ * @returns 1 on success, otherwise 0
+ */
+static int insert_value(TTree *tree, int id, int value){
+    TData_var var_data = {0};
+    TData_func func_data = {0};
+    func_data.parameter_count = value;
+    return insert_symbol(tree, ids[id], FUNCTION, var_data, func_data);
+}
+
+#ifndef SYMTABLE_HASH
+/**
+ * Checks the order, the heights and the balance of a subtree.
+ *
+ * @param root Root of the subtree
+ * @param low Lower bound of the ids (exclusive, NULL for none)
+ * @param high Upper bound of the ids (exclusive, NULL for none)
+ * @returns Height of the subtree, -1 if the subtree is not a valid AVL tree
+ */
+static int check_avl(const TNode *root, const char *low, const char *high){
+    if (root == NULL)
+        return 0;
+    if ((low != NULL && atom_cmp(root->id, low) <= 0) || (high != NULL && atom_cmp(root->id, high) >= 0))
+        return -1;
+    int left = check_avl(root->left_node, low, root->id);
+    int right = check_avl(root->right_node, root->id, high);
+    if (left < 0 || right < 0 || left - right > 1 || right - left > 1)
+        return -1;
+    int height = 1 + ((left > right) ? left : right);
+    return ((int) root->height == height) ? height : -1;
+}
+#endif
+
+/**
+ * Checks the table and all the snapshots against their models.
+ *
+ * @param step Number of the operation
+ * @param tree Table
+ * @param model Model of the table
+ * @param snaps Snapshots
+ * @param snap_models Models of the snapshots
+ * @param snap_count Number of the snapshots
+ */
+static void check_all(int step, TTree *tree, const Model_T *model, const TSnapshot *snaps, const Model_T *snap_models, int snap_count){
+    for (int i = 0; i < TEST_IDS; i++){
+        if (node_value(search_symbol(tree, ids[i])) != model->value[i])
+            fail(step, "table differs from the model", i);
+        for (int s = 0; s < snap_count; s++)
+            if (node_value(search_snapshot(&snaps[s], ids[i])) != snap_models[s].value[i])
+                fail(step, "snapshot differs from its model", i);
+    }
+#ifndef SYMTABLE_HASH
+    if (check_avl(tree->root, NULL, NULL) < 0)
+        fail(step, "table is not an AVL tree", 0);
+    for (int s = 0; s < snap_count; s++)
+        if (check_avl(snaps[s].root, NULL, NULL) < 0)
+            fail(step, "snapshot is not an AVL tree", 0);
+#endif
+}
+
+int main(){
+    Atom_Table_T atoms;
+    atom_table_init(&atoms);
+    for (int i = 0; i < TEST_IDS; i++){
+        char name[16];
+        int len = sprintf(name, "id_%d", i);
+        ids[i] = atom_intern(&atoms, name, (size_t) len);
+    }
+
+    TTree tree;
+    init_symtable(&tree);
+    static Model_T model, snap_models[TEST_SNAPSHOTS];
+    TSnapshot snaps[TEST_SNAPSHOTS];
+    int snap_count = 0;
+    memset(&model, 0, sizeof(model));
+
+    for (int step = 1; step <= TEST_STEPS; step++){
+        int id = random_below(TEST_IDS);
+        int op = random_below(100);
+        if (op < 45){ // Insert (or overwrite)
+            int value = step;
+            if (insert_value(&tree, id, value) == 0)
+                fail(step, "insert failed", id);
+            model.value[id] = value;
+        } else if (op < 80){ // Delete
+            if (delete_symbol(&tree, ids[id]) != (model.value[id] != 0))
+                fail(step, "delete returned a wrong result", id);
+            model.value[id] = 0;
+        } else if (op < 95){ // Edit in place
+            TNode *node = edit_symbol(&tree, ids[id]);
+            if ((node != NULL) != (model.value[id] != 0))
+                fail(step, "edit returned a wrong node", id);
+            if (node != NULL){
+                node->data.function_data.parameter_count = -step;
+                model.value[id] = -step;
+            }
+        } else if (op < 98 || snap_count == 0){ // Snapshot (the oldest one is dropped when there are too many)
+            if (snap_count == TEST_SNAPSHOTS){
+                release_snapshot(&snaps[0]);
+                memmove(&snaps[0], &snaps[1], (TEST_SNAPSHOTS - 1) * sizeof(TSnapshot));
+                memmove(&snap_models[0], &snap_models[1], (TEST_SNAPSHOTS - 1) * sizeof(Model_T));
+                snap_count--;
+            }
+            if (snapshot_symtable(&tree, &snaps[snap_count]) == 0)
+                fail(step, "snapshot failed", id);
+            snap_models[snap_count++] = model;
+        } else { // Restore
+            int s = random_below(snap_count);
+            if (restore_symtable(&tree, &snaps[s]) == 0)
+                fail(step, "restore failed", id);
+            model = snap_models[s];
+        }
+        if (step % 500 == 0)
+            check_all(step, &tree, &model, snaps, snap_models, snap_count);
+    }
+    check_all(TEST_STEPS, &tree, &model, snaps, snap_models, snap_count);
+
+    for (int s = 0; s < snap_count; s++)
+        release_snapshot(&snaps[s]);
+    dispose_symtable(&tree);
+    atom_table_clean(&atoms);
+
+    if (failures > 0){
+        fprintf(stderr, "symtable_snapshot_test: %d failed checks\n", failures);
+        return 1;
+    }
+    printf("symtable_snapshot_test: %d operations, every snapshot kept its version\n", TEST_STEPS);
+    return 0;
+}
@@ -0,0 +1,678 @@
+/* ****************************** token_stream.c ***************************** */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Scan the whole source before parsing                        */
+/* *************************************************************************** */
+
+#define _POSIX_C_SOURCE 200809L   // sysconf(), pthreads
+
+#include "token_stream.h"   // header file
+#include <stdlib.h>         // malloc(), realloc(), free()
+#include <string.h>         // memchr()
+#include <stdint.h>         // SIZE_MAX
+#include <unistd.h>         // sysconf()
+
+/**
+ * Resizes one of the parallel arrays.
+ *
+ * @param array Array to be resized
+ * @param size Size of one item in bytes
+ * @param capacity New number of items
+ * @returns true if the array was resized, false otherwise
+ */
+static bool resize_array(void **array, size_t size, size_t capacity){
+    void *new_array = realloc(*array, size * capacity);
+    if (new_array == NULL) // Realloc failed
+        return false;
+    *array = new_array;
+    return true;
+}
+
+/**
+ * Makes room for more tokens.
+ *
+ * @param ts Token stream
+ * @param n Number of the tokens to make room for
+ * @returns true if there is room for the tokens, false otherwise
+ */
+static bool reserve_tokens(Token_Stream_T *ts, size_t n){
+    if (ts->count + n <= ts->capacity)
+        return true;
+
+    size_t capacity = (ts->capacity == 0) ? TOKEN_STREAM_DEFAULT_SIZE : ts->capacity * 2;
+    while (capacity < ts->count + n)
+        capacity *= 2;
+    if (!resize_array((void **) &ts->types, sizeof(*ts->types), capacity) ||
+        !resize_array((void **) &ts->flags, sizeof(*ts->flags), capacity) ||
+        !resize_array((void **) &ts->offsets, sizeof(*ts->offsets), capacity) ||
+        !resize_array((void **) &ts->lens, sizeof(*ts->lens), capacity) ||
+        !resize_array((void **) &ts->value_ids, sizeof(*ts->value_ids), capacity))
+        return false;
+    ts->capacity = capacity;
+    return true;
+}
+
+/**
+ * Stores the value of a token in the value pool.
+ *
+ * @param ts Token stream
+ * @param value Value to be stored
+ * @returns Index of the value, TOKEN_STREAM_NO_VALUE if the allocation failed
+ */
+static uint32_t add_value(Token_Stream_T *ts, Token_Stream_Value_T value){
+    if (ts->values_count == ts->values_capacity){ // Allocate more memory if needed
+        size_t capacity = (ts->values_capacity == 0) ? TOKEN_STREAM_DEFAULT_SIZE : ts->values_capacity * 2;
+        if (capacity >= TOKEN_STREAM_NO_VALUE || !resize_array((void **) &ts->values, sizeof(*ts->values), capacity))
+            return TOKEN_STREAM_NO_VALUE;
+        ts->values_capacity = capacity;
+    }
+    ts->values[ts->values_count] = value;
+    return (uint32_t) ts->values_count++;
+}
+
+/**
+ * Sets up an empty token stream.
+ *
+ * @param ts Token stream to be set up
+ */
+void token_stream_init(Token_Stream_T *ts){
+    ts->types = NULL;
+    ts->flags = NULL;
+    ts->offsets = NULL;
+    ts->lens = NULL;
+    ts->value_ids = NULL;
+    ts->count = 0;
+    ts->capacity = 0;
+    ts->values = NULL;
+    ts->values_count = 0;
+    ts->values_capacity = 0;
+    ts->pos = 0;
+    ts->error = NO_ERR;
+}
+
+/**
+ * Appends a scanned token to the token stream.
+ *
+ * @param ts Token stream
+ * @param token Scanned token (its can_be_nil flag is cleared)
+ * @returns true if the token was appended, false if an allocation failed
+ */
+static bool add_token(Token_Stream_T *ts, Token_T *token){
+    if (!reserve_tokens(ts, 1))
+        return false;
+
+    Token_Stream_Value_T value;
+    bool has_value = true;
+    unsigned char flags = 0;
+    switch (token->token_type){
+        case TOKEN_KEYWORD:
+            value.token_keyword = token->token_value.token_keyword;
+            if (token->can_be_nil){ // get_token() never clears the flag
+                flags |= TOKEN_FLAG_NIL;
+                token->can_be_nil = false;
+            }
+            break;
+        case TOKEN_FUNC_ID:
+        case TOKEN_VAR_ID:
+        case TOKEN_STR:
+        case TOKEN_M_LINE_STR:
+            value.str = token->token_value.str;
+            break;
+        case TOKEN_INT:
+            value.num_integer = token->token_value.num_integer;
+            break;
+        case TOKEN_FLOAT:
+            value.num_decimal = token->token_value.num_decimal;
+            break;
+        default: // Tokens without a value
+            has_value = false;
+            break;
+    }
+
+    uint32_t value_id = TOKEN_STREAM_NO_VALUE;
+    if (has_value && (value_id = add_value(ts, value)) == TOKEN_STREAM_NO_VALUE)
+        return false; // The value couldn't be stored
+
+    ts->types[ts->count] = (unsigned char) token->token_type;
+    ts->flags[ts->count] = flags;
+    ts->offsets[ts->count] = token->lexeme.offset;
+    ts->lens[ts->count] = token->lexeme.len;
+    ts->value_ids[ts->count] = value_id;
+    ts->count++;
+    return true;
+}
+
+/**
+ * Copies tokens of another token stream into the token stream (there has to be room for them).
+ *
+ * @param ts Token stream
+ * @param at Index to copy the tokens to
+ * @param src Token stream to copy the tokens from
+ * @param from Index of the first token to be copied
+ * @param n Number of the tokens to be copied
+ * @returns true if the tokens were copied, false if an allocation failed
+ */
+static bool copy_tokens(Token_Stream_T *ts, size_t at, Token_Stream_T *src, size_t from, size_t n){
+    for (size_t i = 0; i < n; i++){
+        uint32_t value_id = src->value_ids[from + i];
+        if (value_id != TOKEN_STREAM_NO_VALUE && (value_id = add_value(ts, src->values[value_id])) == TOKEN_STREAM_NO_VALUE)
+            return false;
+        ts->types[at + i] = src->types[from + i];
+        ts->flags[at + i] = src->flags[from + i];
+        ts->offsets[at + i] = src->offsets[from + i];
+        ts->lens[at + i] = src->lens[from + i];
+        ts->value_ids[at + i] = value_id;
+    }
+    return true;
+}
+
+/**
+ * Scans the whole source into the token stream.
+ *
+ * @param ts Token stream to be filled
+ * @returns 0 ~ NO_ERR               — The source was scanned (a lexical error is stored in ts->error)
+ *          99 ~ COMPILER_ERR_INTER  — An allocation failed
+ */
+int token_stream_build(Token_Stream_T *ts){
+    token_stream_init(ts);
+
+    Token_T token;
+    token.can_be_nil = false;
+    do {
+        int result = get_token(&token);
+        if (result != NO_ERR){ // The parser gets the error after the last scanned token
+            ts->error = result;
+            return NO_ERR;
+        }
+        if (!add_token(ts, &token))
+            return COMPILER_ERR_INTER;
+    } while (token.token_type != TOKEN_EOF);
+
+    return NO_ERR;
+}
+
+/**
+ * Moves all the complete tokens of the fed input to the token stream.
+ *
+ * @param ts Token stream
+ * @param sc Scanner the input is fed to
+ * @returns 0 ~ NO_ERR               — The tokens were moved (a lexical error is stored in ts->error)
+ *          99 ~ COMPILER_ERR_INTER  — An allocation failed
+ */
+static int drain_tokens(Token_Stream_T *ts, Scanner_T *sc){
+    if (ts->error != NO_ERR || (ts->count > 0 && ts->types[ts->count - 1] == TOKEN_EOF))
+        return NO_ERR; // Nothing more is scanned after an error or the EOF
+
+    Token_T token;
+    token.can_be_nil = false;
+    while (1){
+        int result = scanner_get_token(sc, &token);
+        if (result == SCANNER_NEED_INPUT) // The next token is not complete yet
+            return NO_ERR;
+        if (result != NO_ERR){
+            ts->error = result;
+            return NO_ERR;
+        }
+        if (!add_token(ts, &token))
+            return COMPILER_ERR_INTER;
+        if (token.token_type == TOKEN_EOF)
+            return NO_ERR;
+    }
+}
+
+/**
+ * Feeds the next chunk of the input to the scanner and appends all the tokens
+ * that are complete to the token stream right away.
+ *
+ * @param ts Token stream (set up by token_stream_init())
+ * @param sc Scanner set up by scanner_open()
+ * @param buf Next chunk of the input
+ * @param len Length of the chunk
+ * @returns 0 ~ NO_ERR               — The chunk was scanned (a lexical error is stored in ts->error)
+ *          99 ~ COMPILER_ERR_INTER  — An allocation failed
+ */
+int token_stream_feed(Token_Stream_T *ts, Scanner_T *sc, const char *buf, size_t len){
+    if (scanner_feed(sc, buf, len) != NO_ERR)
+        return COMPILER_ERR_INTER;
+    return drain_tokens(ts, sc);
+}
+
+/**
+ * Tells the scanner no more input will be fed and appends the rest of the tokens to the token stream.
+ *
+ * @param ts Token stream (set up by token_stream_init())
+ * @param sc Scanner set up by scanner_open()
+ * @returns 0 ~ NO_ERR               — The input was scanned (a lexical error is stored in ts->error)
+ *          99 ~ COMPILER_ERR_INTER  — An allocation failed
+ */
+int token_stream_finish(Token_Stream_T *ts, Scanner_T *sc){
+    scanner_finish(sc);
+    return drain_tokens(ts, sc);
+}
+
+/**
+ * Scans one chunk of the source (run by its own thread).
+ * The chunk is scanned as if a token started right at its start and the scanning stops
+ * with the first token that starts at (or after) the end of the chunk.
+ *
+ * @param arg Chunk to be scanned (Token_Stream_Chunk_T)
+ * @returns NULL
+ */
+static void *scan_chunk(void *arg){
+    Token_Stream_Chunk_T *chunk = (Token_Stream_Chunk_T *) arg;
+    Token_T token;
+    token.can_be_nil = false;
+
+    token_stream_init(&chunk->tokens);
+    chunk->result = NO_ERR;
+    chunk->eof = false;
+    chunk->stop = chunk->start;
+    while (chunk->stop < chunk->end){
+        int result = scanner_get_token(&chunk->scanner, &token);
+        if (result != NO_ERR){ // The error counts only if the chunk is in sync with the source
+            chunk->tokens.error = result;
+            return NULL;
+        }
+        if (!add_token(&chunk->tokens, &token)){
+            chunk->result = COMPILER_ERR_INTER;
+            break;
+        }
+        if (token.token_type == TOKEN_EOF){
+            chunk->eof = true;
+            break;
+        }
+        chunk->stop = chunk->scanner.source.pos; // The next token is scanned from here
+    }
+    return NULL;
+}
+
+/**
+ * Returns the offset the chunk started to scan its i-th token from.
+ *
+ * @param chunk Scanned chunk
+ * @param i Index of the token in the chunk
+ * @returns Offset in the source
+ */
+static size_t chunk_token_start(Token_Stream_Chunk_T *chunk, size_t i){
+    if (i == 0)
+        return chunk->start;
+    return chunk->tokens.offsets[i - 1] + chunk->tokens.lens[i - 1];
+}
+
+/**
+ * Finds the token of the chunk that was scanned from the given offset.
+ *
+ * @param chunk Scanned chunk
+ * @param pos Offset in the source
+ * @param index Index of the found token
+ * @returns true if the chunk scanned a token from the offset, false otherwise
+ */
+static bool chunk_find(Token_Stream_Chunk_T *chunk, size_t pos, size_t *index){
+    size_t low = 0, high = chunk->tokens.count; // Token starts only grow
+    while (low < high){
+        size_t mid = low + (high - low) / 2;
+        if (chunk_token_start(chunk, mid) < pos)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if (low == chunk->tokens.count || chunk_token_start(chunk, low) != pos)
+        return false;
+    *index = low;
+    return true;
+}
+
+/**
+ * Appends the tokens of the chunk starting with the given one to the token stream.
+ *
+ * @param ts Token stream
+ * @param chunk Scanned chunk
+ * @param from Index of the first token to be appended
+ * @returns true if the tokens were appended, false if an allocation failed
+ */
+static bool append_chunk(Token_Stream_T *ts, Token_Stream_Chunk_T *chunk, size_t from){
+    size_t n = chunk->tokens.count - from;
+    if (!reserve_tokens(ts, n) || !copy_tokens(ts, ts->count, &chunk->tokens, from, n))
+        return false;
+    for (size_t i = ts->count; i < ts->count + n; i++){ // Replace the copies of the IDs with the atoms
+        if (ts->types[i] == TOKEN_VAR_ID || ts->types[i] == TOKEN_FUNC_ID){
+            Token_Stream_Value_T *value = &ts->values[ts->value_ids[i]];
+            if ((value->str = atom_intern(scanner.atoms, value->str, ts->lens[i])) == NULL)
+                return false;
+        }
+    }
+    ts->count += n;
+    return true;
+}
+
+/**
+ * Stitches the scanned chunks into the token stream.
+ * The chunks are used only from the point where the sequential scanning would start a token
+ * at the same offset as the chunk did (the scanner depends only on the offset it starts from),
+ * the tokens up to that point are scanned sequentially again.
+ *
+ * @param ts Token stream to be filled
+ * @param chunks Scanned chunks
+ * @param cnt Number of the chunks
+ * @returns 0 ~ NO_ERR               — The source was scanned (a lexical error is stored in ts->error)
+ *          99 ~ COMPILER_ERR_INTER  — An allocation failed
+ */
+static int stitch_chunks(Token_Stream_T *ts, Token_Stream_Chunk_T *chunks, int cnt){
+    size_t pos = chunks[0].start; // Offset the sequential scanning would continue from
+    Token_T token;
+    token.can_be_nil = false;
+
+    for (int i = 0; i < cnt; i++){
+        Token_Stream_Chunk_T *chunk = &chunks[i];
+        if (chunk->result != NO_ERR)
+            return chunk->result;
+
+        while (pos < chunk->end){
+            size_t index;
+            if (chunk_find(chunk, pos, &index)){ // In sync, the rest of the chunk is valid
+                if (!append_chunk(ts, chunk, index))
+                    return COMPILER_ERR_INTER;
+                if (chunk->eof)
+                    return NO_ERR;
+                pos = chunk->stop;
+                if (chunk->tokens.error != NO_ERR){ // The error is real as well
+                    ts->error = chunk->tokens.error;
+                    return NO_ERR;
+                }
+                break;
+            }
+            if (pos == chunk->stop && chunk->tokens.error != NO_ERR){ // In sync right at the error
+                ts->error = chunk->tokens.error;
+                return NO_ERR;
+            }
+
+            // Not in sync (yet), the next token is scanned again
+            scanner.source.pos = pos;
+            int result = get_token(&token);
+            if (result != NO_ERR){
+                ts->error = result;
+                return NO_ERR;
+            }
+            if (!add_token(ts, &token))
+                return COMPILER_ERR_INTER;
+            if (token.token_type == TOKEN_EOF)
+                return NO_ERR;
+            pos = scanner.source.pos;
+        }
+    }
+    return NO_ERR;
+}
+
+/**
+ * Scans the whole source into the token stream using multiple threads.
+ * The source is split into chunks at the ends of lines and every chunk is scanned
+ * speculatively on its own, the result is the same as the one of token_stream_build().
+ *
+ * @param ts Token stream to be filled
+ * @param threads Number of the threads (0 ~ number of the online processors)
+ * @returns 0 ~ NO_ERR               — The source was scanned (a lexical error is stored in ts->error)
+ *          99 ~ COMPILER_ERR_INTER  — An allocation failed
+ */
+int token_stream_build_parallel(Token_Stream_T *ts, int threads){
+    if (threads <= 0){
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (int) cpus : 1;
+    }
+    if (threads > TOKEN_STREAM_MAX_THREADS)
+        threads = TOKEN_STREAM_MAX_THREADS;
+
+    // The whole source has to be in the memory
+    Input_Buf_T *source = &scanner.source;
+    if (input_buf_load_all(source) != INPUT_BUF_OK) // The sequential scanning reports the error at the right token
+        return token_stream_build(ts);
+    size_t begin = source->pos;
+    size_t size = source->len - begin;
+    if ((size_t) threads > size / TOKEN_STREAM_CHUNK_MIN)
+        threads = (int) (size / TOKEN_STREAM_CHUNK_MIN);
+    if (threads <= 1) // Not worth the threads
+        return token_stream_build(ts);
+
+    Token_Stream_Chunk_T *chunks = (Token_Stream_Chunk_T *) malloc(sizeof(Token_Stream_Chunk_T) * threads);
+    if (chunks == NULL){ // Malloc failed
+        token_stream_init(ts);
+        return COMPILER_ERR_INTER;
+    }
+
+    // Split the source right after the ends of lines
+    int cnt = 0;
+    size_t start = begin;
+    for (int i = 1; i <= threads && start < source->len; i++){
+        size_t end = source->len;
+        if (i < threads){
+            end = begin + size / threads * i;
+            if (end < start)
+                end = start;
+            const unsigned char *eol = memchr(source->data + end, '\n', source->len - end);
+            end = (eol == NULL) ? source->len : (size_t) (eol - source->data) + 1;
+        }
+        chunks[cnt].start = start;
+        chunks[cnt].end = end;
+        input_buf_view(&chunks[cnt].scanner.source, source, start);
+        str_pool_init(&chunks[cnt].scanner.strs);
+        chunks[cnt].scanner.atoms = NULL; // The atom table is not shared, the IDs are interned when stitched
+        chunks[cnt].scanner.suspended = false;
+        cnt++;
+        start = end;
+    }
+    chunks[cnt - 1].end = SIZE_MAX; // The last chunk is scanned up to the EOF
+
+    // Scan the chunks (the first one is scanned by this thread)
+    int started = 1;
+    for (; started < cnt; started++){
+        if (pthread_create(&chunks[started].thread, NULL, scan_chunk, &chunks[started]) != 0)
+            break;
+    }
+    scan_chunk(&chunks[0]);
+    for (int i = started; i < cnt; i++) // The threads that couldn't be created
+        scan_chunk(&chunks[i]);
+    for (int i = 1; i < started; i++)
+        pthread_join(chunks[i].thread, NULL);
+
+    token_stream_init(ts);
+    int result = stitch_chunks(ts, chunks, cnt);
+    if (ts->count > 0) // The scanner continues after the last token
+        source->pos = ts->offsets[ts->count - 1] + ts->lens[ts->count - 1];
+
+    for (int i = 0; i < cnt; i++){
+        str_pool_merge(&scanner.strs, &chunks[i].scanner.strs); // The strings are used by the tokens
+        token_stream_free(&chunks[i].tokens);
+    }
+    free(chunks);
+    return result;
+}
+
+/**
+ * Returns the offset the i-th token of the stream was scanned from.
+ *
+ * @param ts Token stream of the whole source
+ * @param i Index of the token (count for the offset after the last token)
+ * @returns Offset in the source
+ */
+static size_t token_start(Token_Stream_T *ts, size_t i){
+    if (i == 0)
+        return 0;
+    return ts->offsets[i - 1] + ts->lens[i - 1];
+}
+
+/**
+ * Moves the tokens of the stream to another index (there has to be room for them).
+ *
+ * @param ts Token stream
+ * @param to Index to move the tokens to
+ * @param from Index of the first token to be moved
+ * @param n Number of the tokens to be moved
+ * @param shift Number of bytes the tokens moved by in the source (in two's complement)
+ */
+static void move_tokens(Token_Stream_T *ts, size_t to, size_t from, size_t n, size_t shift){
+    memmove(ts->types + to, ts->types + from, n * sizeof(*ts->types));
+    memmove(ts->flags + to, ts->flags + from, n * sizeof(*ts->flags));
+    memmove(ts->offsets + to, ts->offsets + from, n * sizeof(*ts->offsets));
+    memmove(ts->lens + to, ts->lens + from, n * sizeof(*ts->lens));
+    memmove(ts->value_ids + to, ts->value_ids + from, n * sizeof(*ts->value_ids));
+    for (size_t i = to; i < to + n; i++)
+        ts->offsets[i] += shift;
+}
+
+/**
+ * Applies an edit to the source and updates the token stream of the whole source.
+ * Only the tokens from the last token the edit can't affect (the scanner looks one byte past
+ * a token) are scanned again, until a token starts at the same place an old token did after
+ * the edit. From there on the old tokens are kept, only moved by the size change.
+ * The values of the replaced tokens stay in the value pool until the stream is freed.
+ *
+ * @param ts Token stream of the source set by set_file() (built by token_stream_build())
+ * @param offset Offset of the edited range in the source
+ * @param removed Number of the removed bytes
+ * @param inserted Inserted text
+ * @param inserted_len Length of the inserted text
+ * @returns 0 ~ NO_ERR               — The stream was updated (a lexical error is stored in ts->error)
+ *          99 ~ COMPILER_ERR_INTER  — The edit is out of the source or an allocation failed
+ */
+int token_stream_relex(Token_Stream_T *ts, size_t offset, size_t removed, const char *inserted, size_t inserted_len){
+    if (input_buf_edit(&scanner.source, offset, removed, inserted, inserted_len) != INPUT_BUF_OK)
+        return COMPILER_ERR_INTER;
+    size_t edit_end = offset + removed;                       // Old offset of the first byte after the edit
+    size_t shift = (size_t) inserted_len - (size_t) removed;  // Wraps around when the source got shorter
+
+    // First token that examined a byte of the edited range
+    size_t low = 0, high = ts->count;
+    while (low < high){ // Token ends only grow
+        size_t mid = low + (high - low) / 2;
+        if (ts->offsets[mid] + ts->lens[mid] < offset)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    size_t first = low;
+
+    // Old offsets the tokens were scanned from (including the one of the error, if any)
+    size_t starts_cnt = ts->count + (ts->error != NO_ERR ? 1 : 0);
+    size_t old = first; // Next old token to get in sync with
+
+    Token_Stream_T fresh; // Tokens scanned again
+    token_stream_init(&fresh);
+    Token_T token;
+    token.can_be_nil = false;
+    size_t pos = token_start(ts, first);
+    bool in_sync = false;
+    while (1){
+        while (old < starts_cnt && (token_start(ts, old) < edit_end || token_start(ts, old) + shift < pos))
+            old++;
+        if (old < starts_cnt && token_start(ts, old) + shift == pos){ // The rest of the old tokens is valid
+            in_sync = true;
+            break;
+        }
+
+        scanner.source.pos = pos;
+        int result = get_token(&token);
+        if (result != NO_ERR){
+            fresh.error = result;
+            break;
+        }
+        if (!add_token(&fresh, &token)){
+            token_stream_free(&fresh);
+            return COMPILER_ERR_INTER;
+        }
+        if (token.token_type == TOKEN_EOF)
+            break;
+        pos = scanner.source.pos;
+    }
+
+    // Replace the old tokens first..old with the fresh ones
+    size_t kept = in_sync ? ts->count - old : 0;
+    size_t count = first + fresh.count + kept;
+    if (count > ts->count && !reserve_tokens(ts, count - ts->count)){
+        token_stream_free(&fresh);
+        return COMPILER_ERR_INTER;
+    }
+    move_tokens(ts, first + fresh.count, old, kept, shift);
+    if (!copy_tokens(ts, first, &fresh, 0, fresh.count)){
+        token_stream_free(&fresh);
+        return COMPILER_ERR_INTER;
+    }
+    ts->count = count;
+    if (!in_sync)
+        ts->error = fresh.error;
+    ts->pos = 0;
+    scanner.source.pos = token_start(ts, ts->count);
+    token_stream_free(&fresh);
+    return NO_ERR;
+}
+
+/**
+ * Moves to the next token and loads it into the token.
+ * Only the value of the token's type is overwritten and can_be_nil is only ever set,
+ * the same way get_token() does it.
+ *
+ * @param ts Token stream
+ * @param token Token to be loaded
+ * @returns The correct error return code
+ */
+int token_stream_advance(Token_Stream_T *ts, Token_T *token){
+    if (ts->pos >= ts->count){ // Past the last scanned token
+        if (ts->error != NO_ERR)
+            return ts->error;
+        token->token_type = TOKEN_EOF; // Repeat the EOF
+        return NO_ERR;
+    }
+
+    size_t i = ts->pos++;
+    token->token_type = (Token_Type_T) ts->types[i];
+    token->lexeme.offset = ts->offsets[i];
+    token->lexeme.len = ts->lens[i];
+    token->block_comm_cnt = 0;
+    token->symbol = NULL;
+
+    Token_Stream_Value_T *value = (ts->value_ids[i] != TOKEN_STREAM_NO_VALUE) ? &ts->values[ts->value_ids[i]] : NULL;
+    switch (token->token_type){
+        case TOKEN_KEYWORD:
+            token->token_value.token_keyword = value->token_keyword;
+            if (ts->flags[i] & TOKEN_FLAG_NIL)
+                token->can_be_nil = true;
+            break;
+        case TOKEN_FUNC_ID:
+        case TOKEN_VAR_ID:
+        case TOKEN_STR:
+        case TOKEN_M_LINE_STR:
+            token->token_value.str = value->str;
+            break;
+        case TOKEN_INT:
+            token->token_value.num_integer = value->num_integer;
+            break;
+        case TOKEN_FLOAT:
+            token->token_value.num_decimal = value->num_decimal;
+            break;
+        default: // Tokens without a value
+            break;
+    }
+    return NO_ERR;
+}
+
+/**
+ * Frees all the memory held by the token stream.
+ *
+ * @param ts Token stream to be freed
+ */
+void token_stream_free(Token_Stream_T *ts){
+    free(ts->types);
+    free(ts->flags);
+    free(ts->offsets);
+    free(ts->lens);
+    free(ts->value_ids);
+    free(ts->values);
+    ts->types = NULL;
+    ts->flags = NULL;
+    ts->offsets = NULL;
+    ts->lens = NULL;
+    ts->value_ids = NULL;
+    ts->values = NULL;
+    ts->count = ts->capacity = 0;
+    ts->values_count = ts->values_capacity = 0;
+    ts->pos = 0;
+}
+/* End of token_stream.c */
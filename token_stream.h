@@ -0,0 +1,159 @@
+/* ****************************** token_stream.h ***************************** */
+/*  Subject: IFJ/IAL - Project                                                 */
+/*  Date: 17. 10. 2026                                                         */
+/*  Functionality: Header file for token_stream.c                              */
+/* *************************************************************************** */
+
+#ifndef TOKEN_STREAM_H
+#define TOKEN_STREAM_H
+
+#include "scanner.h"
+#include <stdint.h>   // uint32_t
+#include <stddef.h>   // size_t
+#include <pthread.h>  // pthread_t
+
+/* Initial number of tokens the stream has memory for */
+#define TOKEN_STREAM_DEFAULT_SIZE 1024
+
+/* Value index of the tokens without a value (operators, EOL, EOF) */
+#define TOKEN_STREAM_NO_VALUE UINT32_MAX
+
+/* Maximum number of the threads scanning the source */
+#ifndef TOKEN_STREAM_MAX_THREADS
+#define TOKEN_STREAM_MAX_THREADS 64
+#endif
+
+/* Minimum number of bytes of the source per thread (smaller sources are scanned sequentially) */
+#ifndef TOKEN_STREAM_CHUNK_MIN
+#define TOKEN_STREAM_CHUNK_MIN (1 << 20)
+#endif
+
+/* Token flags */
+#define TOKEN_FLAG_NIL 1   // Keyword followed by '?' (can_be_nil)
+
+/*
+ * / ***************** Token_Stream_Value_T ***************** \
+ * / Union that holds the value of one token in the value pool \
+*/
+typedef union Token_Stream_Value {
+    Keywords_T token_keyword; // Keyword value
+    char *str;                // String value (IDs and string literals)
+    int num_integer;          // Integer value
+    double num_decimal;       // Double value
+} Token_Stream_Value_T;
+
+/*
+ * / ************************** Token_Stream_T ************************** \
+ * / Structure that holds all the tokens of the source in parallel arrays \
+ * / (token i ~ types[i], flags[i], offsets[i], lens[i], value_ids[i])    \
+*/
+typedef struct Token_Stream {
+    unsigned char *types;          // Token_Type_T of the tokens
+    unsigned char *flags;          // TOKEN_FLAG_* of the tokens
+    size_t *offsets;               // Offsets of the tokens in the source
+    uint32_t *lens;                // Lengths of the tokens in the source
+    uint32_t *value_ids;           // Indexes into the value pool (TOKEN_STREAM_NO_VALUE if there's none)
+    size_t count;                  // Number of the scanned tokens
+    size_t capacity;               // Number of the tokens there is memory for
+
+    Token_Stream_Value_T *values;  // Value pool (keywords, IDs, literals)
+    size_t values_count;           // Number of the stored values
+    size_t values_capacity;        // Number of the values there is memory for
+
+    size_t pos;                    // Index of the next token for the parser
+    int error;                     // Error that stopped the scanning (reported after the last scanned token)
+} Token_Stream_T;
+
+/*
+ * / ************** token_stream_init() *************** \
+ * / Function that sets up an empty token stream       \
+*/
+void token_stream_init(Token_Stream_T *ts);
+
+/*
+ * / ********************* token_stream_build() ********************* \
+ * / Function that scans the whole source into the token stream        \
+ * / (a lexical error is stored and reported when the parser gets there) \
+*/
+int token_stream_build(Token_Stream_T *ts);
+
+/*
+ * / ******************** Token_Stream_Chunk_T ******************** \
+ * / Structure that holds one chunk of the source scanned by a thread \
+*/
+typedef struct Token_Stream_Chunk {
+    pthread_t thread;        // Thread scanning the chunk
+    Scanner_T scanner;       // Scanner with its own view of the source and its own strings
+    size_t start;            // Offset the chunk is scanned from
+    size_t end;              // Tokens are scanned while they start before this offset
+    size_t stop;             // Offset the next token would be scanned from (or the error was found at)
+    bool eof;                // Indicates if the scanning stopped at the EOF
+    int result;              // COMPILER_ERR_INTER if an allocation failed
+    Token_Stream_T tokens;   // Scanned tokens (a lexical error is stored in tokens.error)
+} Token_Stream_Chunk_T;
+
+/*
+ * / ********************** token_stream_feed() ********************** \
+ * / Function that feeds the next chunk of the input to the scanner    \
+ * / and appends the complete tokens to the token stream right away    \
+*/
+int token_stream_feed(Token_Stream_T *ts, Scanner_T *sc, const char *buf, size_t len);
+
+/*
+ * / ********************* token_stream_finish() ********************* \
+ * / Function that ends the input and appends the rest of the tokens   \
+*/
+int token_stream_finish(Token_Stream_T *ts, Scanner_T *sc);
+
+/*
+ * / ****************** token_stream_build_parallel() ****************** \
+ * / Function that scans the whole source into the token stream using    \
+ * / multiple threads (the result is the same as of token_stream_build()) \
+*/
+int token_stream_build_parallel(Token_Stream_T *ts, int threads);
+
+/*
+ * / ********************** token_stream_relex() ********************** \
+ * / Function that applies an edit to the source and scans again only  \
+ * / the tokens around it (until the old tokens are in sync again)      \
+*/
+int token_stream_relex(Token_Stream_T *ts, size_t offset, size_t removed, const char *inserted, size_t inserted_len);
+
+/*
+ * / *********************** token_stream_peek() *********************** \
+ * / Function that loads the type of the k-th token ahead of the parser  \
+ * / without moving to it (returns the error that stopped the scanning   \
+ * / once the scanned tokens run out, like token_stream_advance())        \
+*/
+static inline int token_stream_peek(Token_Stream_T *ts, size_t k, Token_Type_T *type){
+    if (ts->pos + k >= ts->count){ // Nothing was scanned after the EOF (or an error)
+        *type = TOKEN_EOF;
+        return ts->error;
+    }
+    *type = (Token_Type_T) ts->types[ts->pos + k];
+    return NO_ERR;
+}
+
+/*
+ * / *********************** token_stream_skip() *********************** \
+ * / Function that skips all the following tokens of the given type      \
+*/
+static inline void token_stream_skip(Token_Stream_T *ts, Token_Type_T type){
+    while (ts->pos < ts->count && ts->types[ts->pos] == type)
+        ts->pos++;
+}
+
+/*
+ * / ********************* token_stream_advance() ********************* \
+ * / Function that moves to the next token and loads it into the token  \
+*/
+int token_stream_advance(Token_Stream_T *ts, Token_T *token);
+
+/*
+ * / ****************** token_stream_free() ******************* \
+ * / Function that frees all the memory held by the token stream \
+*/
+void token_stream_free(Token_Stream_T *ts);
+
+#endif
+/* End of token_stream.h */
@@ -6,9 +6,54 @@
 /* *************************************************************************** */
 
 #include "utils.h"    // header file
-#include <string.h>   // strcmp()
+#include <string.h>   // memcmp(), strlen()
 #include <ctype.h>    // isdigit()
 
+/* Hash of a keyword candidate (perfect for the Keywords_T set, no collisions) */
+#define KEYWORD_HASH(len, first, last) ((2*(len) + (first) + 8*(last)) & (KEYWORD_HASH_SIZE - 1))
+
+/*
+ * / **************** Keyword_Entry_T **************** \  
+ * / Structure that holds one slot of the keyword table \
+*/
+typedef struct Keyword_Entry{
+    const char *name;    // Keyword (NULL for the empty slots)
+    size_t len;          // Length of the keyword
+    Keywords_T keyword;  // Keyword value
+} Keyword_Entry_T;
+
+// Keywords indexed by KEYWORD_HASH()
+static const Keyword_Entry_T keyword_table[KEYWORD_HASH_SIZE] = {
+    [2]  = {"let",    3, LET_KW},
+    [4]  = {"nil",    3, NIL_KW},
+    [5]  = {"else",   4, ELSE_KW},
+    [6]  = {"func",   4, FUNC_KW},
+    [7]  = {"String", 6, STRING_KW},
+    [8]  = {"Double", 6, DOUBLE_KW},
+    [9]  = {"while",  5, WHILE_KW},
+    [12] = {"var",    3, VAR_KW},
+    [13] = {"if",     2, IF_KW},
+    [14] = {"return", 6, RETURN_KW},
+    [15] = {"Int",    3, INT_KW},
+};
+
+/**
+ * Classifies the identifier as a keyword or not.
+ *
+ * @param str Characters of the identifier (doesn't have to be '\0' terminated)
+ * @param len Length of the identifier
+ * @returns Index of the matched keyword, -1 if the identifier is not a keyword
+ */
+int keyword_classify(const char *str, size_t len){
+    if (len < KEYWORD_MIN_LEN || len > KEYWORD_MAX_LEN) // Too short or too long to be a keyword
+        return -1;
+
+    const Keyword_Entry_T *entry = &keyword_table[KEYWORD_HASH(len, (unsigned char) str[0], (unsigned char) str[len - 1])];
+    if (entry->len == len && memcmp(entry->name, str, len) == 0) // The only possible keyword
+        return entry->keyword;
+    return -1;
+}
+
 /**
  * Checks if string is a keyword or not.
  *
@@ -16,33 +61,9 @@
  * @returns Index of the matched keyword, -1 if the string is not a keyword
  */
 int keyword_cmpr(char *str_token){
-    if (!strcmp(str_token, "while")){
-        return 0;
-    } else if (!strcmp(str_token, "if")){
-        return 1;
-    } else if (!strcmp(str_token, "else")){
-        return 2;
-    } else if (!strcmp(str_token, "func")){
-        return 3;
-    } else if (!strcmp(str_token, "return")){
-        return 4;
-    } else if (!strcmp(str_token, "Int")){
-        return 5;
-    } else if (!strcmp(str_token, "Double")){
-        return 6;
-    } else if (!strcmp(str_token, "String")){
-        return 7;
-    } else if (!strcmp(str_token, "let")){
-        return 8;
-    } else if (!strcmp(str_token, "var")){
-        return 9;
-    } else if (!strcmp(str_token, "nil")){
-        return 10;
-    } else {
-        return -1; // The string is not a keyword
-    }
+    return keyword_classify(str_token, strlen(str_token));
 }
-    
+
 /**
  * Converts hexadecimal digits to decimal values.
  *
@@ -61,5 +82,6 @@ int hex_to_dec(char digit){
     else{
         return -1; // The digit is not a hexadecimal value
     }
+    return value;
 }
 /* End of utils.c */
\ No newline at end of file
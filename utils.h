@@ -8,6 +8,8 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stddef.h>   // size_t
+
 /*
  * / ***************************** FSM_States_T ******************************* \  
  * / Enumeration that holds all the possible states of the Finite-state machine \
@@ -16,53 +18,102 @@ typedef enum FSM_States {
     /* ***************************************************************************************** */
     /*      STATE       ||       SYMBOL      ||      FINAL STATE       ||          INDEX         */
     /* ***************************************************************************************** */
-    FSM_START,          //                   ||                        ||            0           //
-    FSM_PLUS,           //         +         ||          true          ||            1           //
-    FSM_MINUS,          //         -         ||          true          ||            2           //
-    FSM_ARROW,          //         ->        ||          true          ||            3           //
-    FSM_MUL,            //         *         ||          true          ||            4           //
-    FSM_DIV,            //         /         ||          true          ||            5           //
-    FSM_BLOCK_COMM_S,   //         /*        ||          false         ||            6           //
-    FSM_BLOCK_COMM_CL,  //        /**        ||          false         ||            7           //
-    FSM_BLOCK_COMMENT,  //        /**/       ||          true          ||            8           //
-    FSM_LINE_COMM_S,    //         //        ||          false         ||            9           //
-    FSM_LINE_COMMENT,   //  // + {EOL/EOF}   ||          true          ||            10          //
-    FSM_GREATER,        //         >         ||          true          ||            11          //
-    FSM_GREATER_EQL,    //         >=        ||          true          ||            12          //
-    FSM_LESS,           //         <         ||          true          ||            13          //
-    FSM_LESS_EQL,       //         <=        ||          true          ||            14          //
-    FSM_ASSIGN,         //         =         ||          true          ||            15          //
-    FSM_EQLS,           //         ==        ||          true          ||            16          //
-    FSM_EXCL_MARK,      //         !         ||          true          ||            17          //
-    FSM_NOT_EQLS,       //         !=        ||          true          ||            18          //
-    FSM_L_PAR,          //         (         ||          true          ||            19          //
-    FSM_R_PAR,          //         )         ||          true          ||            20          //
-    FSM_L_BRAC,         //         {         ||          true          ||            21          //
-    FSM_R_BRAC,         //         }         ||          true          ||            22          //
-    FSM_COLON,          //         :         ||          true          ||            23          //
-    FSM_UNDER_L,        //         _         ||          true          ||            24          //
-    FSM_COMMA,          //         ,         ||          true          ||            25          //
-    FSM_QUESTION_MARK,  //         ?         ||          false         ||            26          //
-    FSM_NILL_CMP,       //         ??        ||          true          ||            27          //
-    FSM_INT,            //         15        ||          true          ||            28          //
-    FSM_FLOAT_S,        //         15.       ||          false         ||            29          //
-    FSM_FLOAT,          //        15.2       ||          true          ||            30          //
-    FSM_EXP_S,          //        15.2e      ||          false         ||            31          //
-    FSM_EXP_SIGN,       //       15.2e+      ||          false         ||            32          //
-    FSM_EXP,            //      15.2e+4      ||          true          ||            33          //
-    FSM_STRING_S,       //         "         ||          false         ||            34          //
-    FSM_ESC_SEQ,        //         "/        ||          false         ||            35          //
-    FSM_HEXA_SEQ_S,     //        "/u        ||          false         ||            36          //
-    FSM_HEXA_SEQ,       //       "/u{A       ||          false         ||            37          //
-    FSM_STRING,         //      "/u{A}"      ||          true          ||            38          //
-    FSM_M_LINE_STR_S,   //     """Ah\noj     ||          false         ||            39          //
-    FSM_M_LINE_STR,     //    """Ah\noj"""   ||          true          ||            40          //
-    FSM_ID,             //       Var123_     ||          true          ||            41          //
-    FSM_EOF,            //        EOF        ||          true          ||            42          //
-    FSM_EOL,            //        EOL        ||          true          ||            43          //
-    FSM_ERROR,          //        1.2e       ||          true          ||            44          //
+    FSM_START,          //                   ||                        ||           0            //
+    FSM_PLUS,           //         +         ||          true          ||           1            //
+    FSM_MINUS,          //         -         ||          true          ||           2            //
+    FSM_ARROW,          //        ->         ||          true          ||           3            //
+    FSM_MUL,            //         *         ||          true          ||           4            //
+    FSM_DIV,            //         /         ||          true          ||           5            //
+    FSM_BLOCK_COMM_S,   //        /*         ||         false          ||           6            //
+    FSM_NESTED_COMM,    //       /* /        ||         false          ||           7            //
+    FSM_BLOCK_COMM_CL,  //        /**        ||         false          ||           8            //
+    FSM_BLOCK_COMMENT,  //       /**/        ||          true          ||           9            //
+    FSM_LINE_COMM_S,    //        //         ||         false          ||           10           //
+    FSM_LINE_COMMENT,   //  // + {EOL/EOF}   ||          true          ||           11           //
+    FSM_GREATER,        //         >         ||          true          ||           12           //
+    FSM_GREATER_EQL,    //        >=         ||          true          ||           13           //
+    FSM_LESS,           //         <         ||          true          ||           14           //
+    FSM_LESS_EQL,       //        <=         ||          true          ||           15           //
+    FSM_ASSIGN,         //         =         ||          true          ||           16           //
+    FSM_EQLS,           //        ==         ||          true          ||           17           //
+    FSM_EXCL_MARK,      //         !         ||          true          ||           18           //
+    FSM_NOT_EQLS,       //        !=         ||          true          ||           19           //
+    FSM_L_PAR,          //         (         ||          true          ||           20           //
+    FSM_R_PAR,          //         )         ||          true          ||           21           //
+    FSM_L_BRAC,         //         {         ||          true          ||           22           //
+    FSM_R_BRAC,         //         }         ||          true          ||           23           //
+    FSM_COLON,          //         :         ||          true          ||           24           //
+    FSM_UNDER_L,        //         _         ||          true          ||           25           //
+    FSM_COMMA,          //         ,         ||          true          ||           26           //
+    FSM_QUESTION_MARK,  //         ?         ||         false          ||           27           //
+    FSM_NILL_CMP,       //        ??         ||          true          ||           28           //
+    FSM_INT,            //        15         ||          true          ||           29           //
+    FSM_FLOAT_S,        //        15.        ||         false          ||           30           //
+    FSM_FLOAT,          //       15.2        ||          true          ||           31           //
+    FSM_EXP_S,          //       15.2e       ||         false          ||           32           //
+    FSM_EXP_SIGN,       //      15.2e+       ||         false          ||           33           //
+    FSM_EXP,            //      15.2e+4      ||          true          ||           34           //
+    FSM_STRING_S,       //         "         ||         false          ||           35           //
+    FSM_ESC_SEQ,        //        "/         ||         false          ||           36           //
+    FSM_HEXA_SEQ_S,     //        "/u        ||         false          ||           37           //
+    FSM_HEXA_SEQ,       //       "/u{A       ||         false          ||           38           //
+    FSM_HEXA_DIGIT,     //      "/u{A4       ||         false          ||           39           //
+    FSM_STRING,         //      "/u{A}"      ||          true          ||           40           //
+    FSM_M_LINE_STR_S,   //     """Ah\noj     ||         false          ||           41           //
+    FSM_M_LINE_STR_Q1,  //    """Ah\noj"     ||         false          ||           42           //
+    FSM_M_LINE_STR_Q2,  //    """Ah\noj""    ||         false          ||           43           //
+    FSM_M_LINE_STR,     //   """Ah\noj"""    ||          true          ||           44           //
+    FSM_ID,             //      Var123_      ||          true          ||           45           //
+    FSM_EOF,            //        EOF        ||          true          ||           46           //
+    FSM_EOL,            //        EOL        ||          true          ||           47           //
+    FSM_ERROR,          //       1.2e        ||          true          ||           48           //
+    FSM_ACCEPT,         //                   ||         pseudo         ||           49           //
+    FSM_STATES_CNT      //                   ||         count          ||           50           //
 } FSM_States_T;
 
+/*
+ * / ************************** Char_Class_T **************************** \  
+ * / Enumeration that holds the classes of characters the FSM tells apart \
+*/ 
+typedef enum Char_Class {
+    /* ************************************************************* */
+    /*      CLASS       ||       CHARACTERS       ||       INDEX     */
+    /* ************************************************************* */
+    CC_EOF,             //          EOF           ||        0        //
+    CC_PLUS,            //           +            ||        1        //
+    CC_MINUS,           //           -            ||        2        //
+    CC_STAR,            //           *            ||        3        //
+    CC_SLASH,           //           /            ||        4        //
+    CC_GREATER,         //           >            ||        5        //
+    CC_LESS,            //           <            ||        6        //
+    CC_EQUAL,           //           =            ||        7        //
+    CC_EXCL,            //           !            ||        8        //
+    CC_QUESTION,        //           ?            ||        9        //
+    CC_L_PAR,           //           (            ||       10        //
+    CC_R_PAR,           //           )            ||       11        //
+    CC_L_BRAC,          //           {            ||       12        //
+    CC_R_BRAC,          //           }            ||       13        //
+    CC_COLON,           //           :            ||       14        //
+    CC_COMMA,           //           ,            ||       15        //
+    CC_UNDER_L,         //           _            ||       16        //
+    CC_DOT,             //           .            ||       17        //
+    CC_QUOTE,           //           "            ||       18        //
+    CC_BACKSLASH,       //           \            ||       19        //
+    CC_DIGIT,           //          0-9           ||       20        //
+    CC_HEX_ALPHA,       //        A-F a-f         ||       21        //
+    CC_EXP,             //          e E           ||       22        //
+    CC_ESC_CHAR,        //         n t r          ||       23        //
+    CC_ESC_U,           //           u            ||       24        //
+    CC_ALPHA,           //     other letters      ||       25        //
+    CC_BLANK,           //         space          ||       26        //
+    CC_TAB,             //           \t           ||       27        //
+    CC_SPACE_CTRL,      //        \v \f \r        ||       28        //
+    CC_EOL,             //           \n           ||       29        //
+    CC_CTRL,            //       other < 32       ||       30        //
+    CC_OTHER,           //     anything else      ||       31        //
+    CHAR_CLASS_CNT      //         count          ||       32        //
+} Char_Class_T;
+
 /*
  * / ****************** Keywords_T ****************** \  
  * / Enumeration that holds all the possible keywords \
@@ -86,6 +137,19 @@ typedef enum Keywords{
     NIL_KW,
 } Keywords_T;
 
+/* Shortest ("if") and longest ("return", "Double", "String") keyword */
+#define KEYWORD_MIN_LEN 2
+#define KEYWORD_MAX_LEN 6
+
+/* Number of slots in the keyword hash table */
+#define KEYWORD_HASH_SIZE 16
+
+/*
+ * / ******************* keyword_classify() ******************* \  
+ * / Function that checks if the identifier (ptr, len) is a keyword \
+*/
+int keyword_classify(const char *str, size_t len);
+
 /*
  * / *************** keyword_cmpr() ***************** \  
  * / Function that checks if the string is a keyword  \